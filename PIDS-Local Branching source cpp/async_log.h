@@ -0,0 +1,452 @@
+/************************************************************
+     async_log.h - Asynchronous logging for the solver threads
+ ***********************************************************/
+
+#ifndef ASYNC_LOG_H
+#define ASYNC_LOG_H
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+ * Logging that never blocks the search. Each thread formats a line in a fixed
+ * buffer and pushes it into its own single-producer ring of fixed-size slots (no
+ * lock, no allocation on the push path). A background writer drains the rings, restores
+ * the global order with a sequence number and writes each record to every sink
+ * in its mask: the console (plain text) and files (one structured line per
+ * record: seconds since start, level, thread, message). When a ring is full the
+ * record is dropped and counted instead of waiting.
+ *
+ * Levels: LOG_ERROR < LOG_INFO < LOG_DEBUG. PIDS_LOG_MAX_LEVEL removes the
+ * higher levels at compile time; setLevel() filters at run time. With the
+ * PIDS_LOG macro a filtered line, or one with no sink, costs a comparison or two
+ * and its arguments are not evaluated (nor is the writer thread started).
+ *
+ *   PIDS_LOG(LOG_INFO, LOG_CONSOLE | file.mask()) << "score " << s;
+ */
+
+enum LogLevel { LOG_ERROR = 0, LOG_INFO = 1, LOG_DEBUG = 2 };
+
+#ifndef PIDS_LOG_MAX_LEVEL
+#define PIDS_LOG_MAX_LEVEL LOG_DEBUG
+#endif
+
+const uint64_t LOG_CONSOLE = 1;  // Sink 0; files use bits 1..63
+
+class AsyncLog {
+public:
+    static AsyncLog& instance() {
+        static AsyncLog log;
+        return log;
+    }
+
+    int level() const { return level_.load(std::memory_order_relaxed); }
+    void setLevel(int level) { level_.store(level, std::memory_order_relaxed); }
+
+    // Opens a file sink; returns its id (1..63) or -1
+    int openFile(const std::string& path) {
+        FILE* f = fopen(path.c_str(), "w");
+        if (!f) return -1;
+        std::lock_guard<std::mutex> lock(sinksMutex_);
+        for (int id = 1; id < 64; ++id) {
+            if (!files_[id]) {
+                files_[id] = f;
+                return id;
+            }
+        }
+        fclose(f);
+        return -1;
+    }
+
+    // Writes everything already pushed to the file, then closes it
+    void closeFile(int id) {
+        if (id <= 0 || id >= 64) return;
+        flush();
+        std::lock_guard<std::mutex> lock(sinksMutex_);
+        if (files_[id]) fclose(files_[id]);
+        files_[id] = NULL;
+    }
+
+    // Plain text straight to a file sink, after flush(): for large blocks such as final results
+    void writeDirect(int id, const std::string& text) {
+        if (id <= 0 || id >= 64) return;
+        std::lock_guard<std::mutex> lock(sinksMutex_);
+        if (files_[id]) {
+            fwrite(text.data(), 1, text.size(), files_[id]);
+            fflush(files_[id]);
+        }
+    }
+
+    // Plain text straight to the console, after flush(): usage, final results
+    void writeConsole(const std::string& text) {
+        flush();
+        std::lock_guard<std::mutex> lock(sinksMutex_);
+        fwrite(text.data(), 1, text.size(), stdout);
+        fflush(stdout);
+    }
+
+    // Lock-free for the calling thread; false if the record was dropped (ring full)
+    bool push(uint64_t sinks, int level, const char* text, size_t len) {
+        Ring* ring = localRing();
+        size_t needed = std::max<size_t>(1, (len + SLOT_TEXT - 1) / SLOT_TEXT);
+        uint64_t head = ring->head.load(std::memory_order_relaxed);
+        uint64_t tail = ring->tail.load(std::memory_order_acquire);
+        if (needed > RING_SLOTS - (head - tail)) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        uint64_t seq = sequence_.fetch_add(1, std::memory_order_relaxed);
+        double time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start_).count();
+        for (size_t part = 0; part < needed; ++part) {
+            Slot& s = ring->slots[(head + part) % RING_SLOTS];
+            size_t chunk = std::min<size_t>(SLOT_TEXT, len - std::min(len, part * SLOT_TEXT));
+            s.seq = seq;
+            s.sinks = sinks;
+            s.time = time;
+            s.level = (uint8_t)level;
+            s.more = part + 1 < needed;
+            s.len = (uint16_t)chunk;
+            memcpy(s.text, text + part * SLOT_TEXT, chunk);
+        }
+        ring->head.store(head + needed, std::memory_order_release);
+        if (head == tail) wake_.notify_one();  // The writer may be sleeping on an empty ring
+        return true;
+    }
+
+    // Waits until the writer has written every record pushed before the call
+    void flush() {
+        std::unique_lock<std::mutex> lock(wakeMutex_);
+        uint64_t ticket = ++flushRequested_;
+        wake_.notify_one();
+        flushed_.wait(lock, [&]() { return flushDone_ >= ticket; });
+    }
+
+    long long dropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+    ~AsyncLog() {
+        flush();
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex_);
+            running_ = false;
+        }
+        wake_.notify_one();
+        writer_.join();
+        for (Ring* r : rings_) delete r;
+        for (int id = 1; id < 64; ++id) {
+            if (files_[id]) fclose(files_[id]);
+        }
+        if (dropped() > 0) fprintf(stderr, "async_log: %lld lines dropped (ring full)\n", dropped());
+    }
+
+private:
+    static const size_t SLOT_TEXT = 200;
+    static const size_t RING_SLOTS = 1024;
+
+    struct Slot {
+        uint64_t seq;
+        uint64_t sinks;
+        double time;
+        uint8_t level;
+        uint8_t more;      // The record continues in the next slot
+        uint16_t len;
+        char text[SLOT_TEXT];
+    };
+
+    struct Ring {
+        std::atomic<uint64_t> head;  // Written by the owning thread
+        std::atomic<uint64_t> tail;  // Written by the writer thread
+        std::atomic<bool> orphan;    // Owning thread has exited: freed once drained
+        int thread;
+        Slot slots[RING_SLOTS];
+    };
+
+    struct Record {
+        uint64_t seq;
+        uint64_t sinks;
+        double time;
+        int level;
+        int thread;
+        std::string text;
+        bool operator<(const Record& o) const { return seq < o.seq; }
+    };
+
+    // Marks the thread's ring as orphan when the thread exits
+    struct RingOwner {
+        Ring* ring;
+        RingOwner() : ring(NULL) {}
+        ~RingOwner() {
+            if (ring) ring->orphan.store(true, std::memory_order_release);
+        }
+    };
+
+    AsyncLog()
+        : level_(LOG_INFO), sequence_(0), dropped_(0), nextThread_(0), running_(true),
+          flushRequested_(0), flushDone_(0), start_(std::chrono::steady_clock::now()) {
+        for (int id = 0; id < 64; ++id) files_[id] = NULL;
+        writer_ = std::thread([this]() { run(); });
+    }
+
+    Ring* localRing() {
+        static thread_local RingOwner owner;
+        if (!owner.ring) {
+            Ring* r = new Ring();
+            r->head = 0;
+            r->tail = 0;
+            r->orphan = false;
+            std::lock_guard<std::mutex> lock(ringsMutex_);
+            r->thread = nextThread_++;
+            rings_.push_back(r);
+            owner.ring = r;
+        }
+        return owner.ring;
+    }
+
+    // Moves every complete record out of the rings; frees drained orphan rings
+    void collect(std::vector<Record>& batch) {
+        std::lock_guard<std::mutex> lock(ringsMutex_);
+        for (size_t i = 0; i < rings_.size();) {
+            Ring* r = rings_[i];
+            bool orphan = r->orphan.load(std::memory_order_acquire);
+            uint64_t head = r->head.load(std::memory_order_acquire);
+            uint64_t tail = r->tail.load(std::memory_order_relaxed);
+            while (tail < head) {
+                Record rec;
+                const Slot& first = r->slots[tail % RING_SLOTS];
+                rec.seq = first.seq;
+                rec.sinks = first.sinks;
+                rec.time = first.time;
+                rec.level = first.level;
+                rec.thread = r->thread;
+                bool more = true;
+                while (more) {
+                    const Slot& s = r->slots[tail % RING_SLOTS];
+                    rec.text.append(s.text, s.len);
+                    more = s.more;
+                    tail++;
+                }
+                batch.push_back(rec);
+            }
+            r->tail.store(tail, std::memory_order_release);
+            if (orphan && tail == r->head.load(std::memory_order_acquire)) {
+                delete r;
+                rings_.erase(rings_.begin() + i);
+            } else {
+                ++i;
+            }
+        }
+    }
+
+    void write(std::vector<Record>& batch) {
+        static const char* names[] = { "ERROR", "INFO", "DEBUG" };
+        std::sort(batch.begin(), batch.end());
+        std::lock_guard<std::mutex> lock(sinksMutex_);
+        bool files = false;
+        for (const Record& rec : batch) {
+            if (rec.sinks & LOG_CONSOLE) {
+                fwrite(rec.text.data(), 1, rec.text.size(), stdout);
+                fputc('\n', stdout);
+            }
+            for (int id = 1; id < 64; ++id) {
+                if (!(rec.sinks & (1ULL << id)) || !files_[id]) continue;
+                fprintf(files_[id], "%.3f\t%s\tt%d\t", rec.time, names[std::min(rec.level, 2)], rec.thread);
+                fwrite(rec.text.data(), 1, rec.text.size(), files_[id]);
+                fputc('\n', files_[id]);
+                files = true;
+            }
+        }
+        if (!batch.empty()) fflush(stdout);
+        if (files) {
+            for (int id = 1; id < 64; ++id) {
+                if (files_[id]) fflush(files_[id]);
+            }
+        }
+    }
+
+    void run() {
+        std::vector<Record> batch;
+        while (true) {
+            uint64_t ticket;
+            bool running;
+            {
+                std::lock_guard<std::mutex> lock(wakeMutex_);
+                ticket = flushRequested_;
+                running = running_;
+            }
+            batch.clear();
+            collect(batch);
+            write(batch);
+            {
+                std::unique_lock<std::mutex> lock(wakeMutex_);
+                if (ticket > flushDone_) {
+                    flushDone_ = ticket;
+                    flushed_.notify_all();
+                }
+                if (!running) break;
+                if (batch.empty() && flushRequested_ == flushDone_ && running_) {
+                    wake_.wait_for(lock, std::chrono::milliseconds(20));
+                }
+            }
+        }
+    }
+
+    std::atomic<int> level_;
+    std::atomic<uint64_t> sequence_;
+    std::atomic<long long> dropped_;
+    int nextThread_;
+    bool running_;
+    uint64_t flushRequested_, flushDone_;
+    std::chrono::steady_clock::time_point start_;
+    FILE* files_[64];
+    std::vector<Ring*> rings_;
+    std::mutex ringsMutex_, sinksMutex_, wakeMutex_;
+    std::condition_variable wake_, flushed_;
+    std::thread writer_;
+};
+
+/*
+ * Formatting buffer of one log line: a fixed array, so formatting a line does
+ * not allocate. A longer line spills into a growing string kept with the buffer
+ * (per thread), which is allocated once and then reused.
+ */
+class LineBuffer : public std::streambuf {
+public:
+    LineBuffer() { reset(); }
+
+    void reset() { setp(fixed_, fixed_ + sizeof fixed_); }
+    const char* data() const { return pbase(); }
+    size_t size() const { return pptr() - pbase(); }
+
+protected:
+    int_type overflow(int_type c) {
+        if (traits_type::eq_int_type(c, traits_type::eof())) return traits_type::not_eof(c);
+        size_t used = size();
+        if (pbase() == fixed_) spill_.assign(fixed_, used);
+        spill_.resize(std::max(2 * used, 2 * sizeof fixed_));
+        setp(&spill_[0], &spill_[0] + spill_.size());
+        pbump((int)used);
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+        return c;
+    }
+
+private:
+    char fixed_[1024];
+    std::string spill_;
+};
+
+struct LineStream {
+    LineBuffer buffer;
+    std::ostream stream;
+    LineStream() : stream(&buffer) {}
+};
+
+/*
+ * One record, built with << and pushed at the end of the statement.
+ * Each thread reuses a few formatting streams, one per nesting depth (a <<
+ * operand that logs itself); only deeper nesting allocates a stream.
+ */
+class LogLine {
+public:
+    LogLine(uint64_t sinks, int level) : sinks_(sinks), level_(level), own_(NULL) {
+        static thread_local LineStream streams[NESTED];
+        static thread_local int depth = 0;
+        depth_ = &depth;
+        if (depth < NESTED) line_ = &streams[depth];
+        else line_ = own_ = new LineStream();
+        depth++;
+        line_->buffer.reset();
+        line_->stream.clear();
+        line_->stream.flags(std::ios::fmtflags(0) | std::ios::dec | std::ios::skipws);
+        line_->stream.precision(6);
+        out_ = &line_->stream;
+    }
+
+    ~LogLine() {
+        if (sinks_) AsyncLog::instance().push(sinks_, level_, line_->buffer.data(), line_->buffer.size());
+        delete own_;
+        (*depth_)--;
+    }
+
+    template <class T>
+    LogLine& operator<<(const T& value) {
+        *out_ << value;
+        return *this;
+    }
+
+    // Manipulators (fixed, setprecision via the template above); endl ends nothing: the statement does
+    LogLine& operator<<(std::ostream& (*manip)(std::ostream&)) {
+        typedef std::ostream& (*Endl)(std::ostream&);
+        if (manip != static_cast<Endl>(std::endl)) manip(*out_);
+        return *this;
+    }
+
+    LogLine& operator<<(std::ios_base& (*manip)(std::ios_base&)) {
+        manip(*out_);
+        return *this;
+    }
+
+private:
+    static const int NESTED = 4;
+
+    LogLine(const LogLine&);
+    LogLine& operator=(const LogLine&);
+
+    uint64_t sinks_;
+    int level_;
+    LineStream* line_;
+    LineStream* own_;
+    std::ostream* out_;
+    int* depth_;
+};
+
+// A file sink, used where a std::ofstream log used to be passed around
+class LogFile {
+public:
+    LogFile() : id_(-1) {}
+    explicit LogFile(const std::string& path) : id_(-1) { open(path); }
+    ~LogFile() { close(); }
+
+    bool open(const std::string& path) {
+        close();
+        id_ = AsyncLog::instance().openFile(path);
+        return id_ > 0;
+    }
+    bool is_open() const { return id_ > 0; }
+    void close() {
+        if (id_ > 0) AsyncLog::instance().closeFile(id_);
+        id_ = -1;
+    }
+
+    // Sink bit for PIDS_LOG (0 if closed: the record goes to the other sinks only)
+    uint64_t mask() const { return id_ > 0 ? (1ULL << id_) : 0; }
+
+    // Plain text after everything already logged (flushes the rings first)
+    void writeDirect(const std::string& text) const {
+        if (id_ <= 0) return;
+        AsyncLog::instance().flush();
+        AsyncLog::instance().writeDirect(id_, text);
+    }
+
+private:
+    LogFile(const LogFile&);
+    LogFile& operator=(const LogFile&);
+
+    int id_;
+};
+
+#define PIDS_LOG(lvl, sinks) \
+    if (!(sinks) || (lvl) > PIDS_LOG_MAX_LEVEL || (lvl) > AsyncLog::instance().level()) {} \
+    else LogLine((sinks), (lvl))
+
+#endif
@@ -0,0 +1,128 @@
+/************************************************************
+     buffered_writer.h - Buffered writer for LP / MST files
+ ***********************************************************/
+
+#ifndef BUFFERED_WRITER_H
+#define BUFFERED_WRITER_H
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <charconv>
+
+/*
+ * Writer used for the LP models and MIP start files handed to CPLEX.
+ * Numbers are formatted with std::to_chars straight into one reusable buffer,
+ * and the buffer is written with a single fwrite (unbuffered FILE, so one
+ * syscall) each time it fills up. Nothing is flushed per line and nothing is
+ * allocated after construction.
+ *
+ * A failed write is sticky: later writes are dropped and flush()/close()
+ * keep returning false until the next open(), so checking close() is enough.
+ *
+ * Set PIDS_TMPDIR=/dev/shm to keep the files in memory (see tmpPath()).
+ */
+class BufferedWriter {
+public:
+    explicit BufferedWriter(size_t capacity = 1 << 20)
+        : buffer_(capacity), used_(0), file_(NULL), failed_(false) {}
+
+    ~BufferedWriter() { close(); }
+
+    bool open(const std::string& filename) {
+        close();
+        file_ = fopen(filename.c_str(), "wb");
+        if (!file_) return false;
+        setvbuf(file_, NULL, _IONBF, 0);
+        used_ = 0;
+        failed_ = false;
+        return true;
+    }
+
+    bool is_open() const { return file_ != NULL; }
+    bool failed() const { return failed_; }
+
+    // Flushes the remaining bytes; returns false if any write failed
+    bool close() {
+        if (!file_) return !failed_;
+        bool ok = flush();
+        ok = (fclose(file_) == 0) && ok;
+        file_ = NULL;
+        return ok;
+    }
+
+    bool flush() {
+        if (file_ && used_ > 0 && !failed_) {
+            failed_ = fwrite(buffer_.data(), 1, used_, file_) != used_;
+        }
+        used_ = 0;
+        return !failed_;
+    }
+
+    BufferedWriter& put(char c) {
+        reserve(1);
+        buffer_[used_++] = c;
+        return *this;
+    }
+
+    BufferedWriter& put(const char* s, size_t len) {
+        while (len > 0) {
+            if (used_ == buffer_.size()) flush();
+            size_t chunk = std::min(len, buffer_.size() - used_);
+            memcpy(buffer_.data() + used_, s, chunk);
+            used_ += chunk;
+            s += chunk;
+            len -= chunk;
+        }
+        return *this;
+    }
+
+    BufferedWriter& put(const char* s) { return put(s, strlen(s)); }
+    BufferedWriter& put(const std::string& s) { return put(s.data(), s.size()); }
+
+    BufferedWriter& putInt(long long value) {
+        reserve(24);
+        std::to_chars_result r = std::to_chars(buffer_.data() + used_,
+                                               buffer_.data() + buffer_.size(), value);
+        used_ = r.ptr - buffer_.data();
+        return *this;
+    }
+
+    BufferedWriter& putDouble(double value) {
+        reserve(32);
+        std::to_chars_result r = std::to_chars(buffer_.data() + used_,
+                                               buffer_.data() + buffer_.size(), value);
+        used_ = r.ptr - buffer_.data();
+        return *this;
+    }
+
+    // LP variable name "x<i+1>" for the 0-based vertex i
+    BufferedWriter& putVar(int i) {
+        put('x');
+        return putInt(i + 1);
+    }
+
+private:
+    void reserve(size_t bytes) {
+        if (used_ + bytes > buffer_.size()) flush();
+    }
+
+    std::vector<char> buffer_;
+    size_t used_;
+    FILE* file_;
+    bool failed_;
+};
+
+// Directory for temporary CPLEX files (PIDS_TMPDIR, e.g. /dev/shm), default: current directory
+inline std::string tmpPath(const std::string& filename) {
+    const char* dir = getenv("PIDS_TMPDIR");
+    if (!dir || dir[0] == '\0') return filename;
+    std::string path(dir);
+    if (path[path.size() - 1] != '/') path += '/';
+    return path + filename;
+}
+
+#endif
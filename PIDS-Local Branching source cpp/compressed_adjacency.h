@@ -0,0 +1,314 @@
+/************************************************************
+     compressed_adjacency.h - Compressed adjacency lists
+ ***********************************************************/
+
+#ifndef COMPRESSED_ADJACENCY_H
+#define COMPRESSED_ADJACENCY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <vector>
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#endif
+
+/*
+ * Sorted adjacency lists of an undirected graph, stored as gaps in the Stream
+ * VByte layout. For each vertex: one control byte per group of 4 neighbours
+ * (2 bits per neighbour: its gap takes 1 to 4 bytes), then the gap bytes. The
+ * gaps are v[0], then v[i] - v[i-1] - 1, so neighbours close in the numbering
+ * (see -ordre) take one byte each. Byte offsets are 64-bit and the edge count
+ * is a long long: the size is only bounded by memory, about 12 bytes per vertex
+ * plus 1.25 to 2 bytes per neighbour (a std::set<int> node is ~40 bytes).
+ *
+ * operator[] returns a read-only range (range-for, size, empty, front, back)
+ * decoded one group of 4 at a time. decode() expands a whole list, with SSSE3
+ * (PSHUFB per group, then a prefix sum) when the CPU has it. Lists are
+ * immutable: build() encodes a whole graph, replace() re-encodes some vertices.
+ */
+class CompressedAdjacency {
+public:
+    class const_iterator {
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef int value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const int* pointer;
+        typedef int reference;
+
+        const_iterator() : control_(NULL), data_(NULL), left_(0), pos_(0), previous_(0) {}
+        const_iterator(const uint8_t* control, const uint8_t* data, int count)
+            : control_(control), data_(data), left_(count), pos_(0), previous_(UINT32_MAX) {
+            if (left_ > 0) load();
+        }
+
+        int operator*() const { return group_[pos_]; }
+        const_iterator& operator++() {
+            --left_;
+            if (++pos_ == 4 && left_ > 0) load();
+            return *this;
+        }
+        const_iterator operator++(int) {
+            const_iterator old = *this;
+            ++*this;
+            return old;
+        }
+        // Only meaningful against end() or an iterator of the same list
+        bool operator==(const const_iterator& o) const { return left_ == o.left_; }
+        bool operator!=(const const_iterator& o) const { return left_ != o.left_; }
+
+    private:
+        void load() {
+            data_ = decodeGroup(data_, *control_++, std::min(left_, 4), previous_, group_);
+            pos_ = 0;
+        }
+
+        const uint8_t* control_;
+        const uint8_t* data_;
+        int left_;
+        int pos_;
+        uint32_t previous_;
+        int group_[4];
+    };
+
+    class List {
+    public:
+        List(const uint8_t* p, int degree) : p_(p), degree_(degree) {}
+        const_iterator begin() const { return const_iterator(p_, p_ + (degree_ + 3) / 4, degree_); }
+        const_iterator end() const { return const_iterator(); }
+        size_t size() const { return degree_; }
+        bool empty() const { return degree_ == 0; }
+        int front() const { return *begin(); }
+        int back() const {
+            int last = -1;
+            for (const_iterator it = begin(); it != end(); ++it) last = *it;
+            return last;
+        }
+
+    private:
+        const uint8_t* p_;
+        int degree_;
+    };
+
+    CompressedAdjacency() : n_(0), maxDegree_(0), ends_(0), offsets_(1, 0), data_(PADDING, 0) {}
+
+    int size() const { return n_; }
+    bool empty() const { return n_ == 0; }
+    List operator[](int v) const { return List(&data_[offsets_[v]], degree_[v]); }
+    int degree(int v) const { return degree_[v]; }
+    int maxDegree() const { return maxDegree_; }
+    long long edges() const { return ends_ / 2; }
+    size_t bytes() const {
+        return data_.capacity() + offsets_.capacity() * sizeof(uint64_t) + degree_.capacity() * sizeof(int);
+    }
+
+    // n vertices, no edges
+    void clear(int n) {
+        std::vector<uint64_t> start(n + 1, 0);
+        std::vector<int> targets;
+        build(n, start, targets);
+    }
+
+    /*
+     * From CSR arrays: the neighbours of v are targets[start[v] .. start[v+1]).
+     * Each range is sorted and deduplicated in place; self-loops are dropped.
+     */
+    void build(int n, const std::vector<uint64_t>& start, std::vector<int>& targets) {
+        n_ = n;
+        maxDegree_ = 0;
+        ends_ = 0;
+        degree_.assign(n, 0);
+        offsets_.assign(n + 1, 0);
+        data_.clear();
+        data_.reserve(targets.size() + targets.size() / 4 + n + PADDING);
+        for (int v = 0; v < n; ++v) {
+            int* first = targets.data() + start[v];
+            int* last = targets.data() + start[v + 1];
+            std::sort(first, last);
+            last = std::unique(first, last);
+            last = std::remove(first, last, v);
+            offsets_[v] = data_.size();
+            degree_[v] = last - first;
+            ends_ += degree_[v];
+            maxDegree_ = std::max(maxDegree_, degree_[v]);
+            encodeList(first, degree_[v], data_);
+        }
+        offsets_[n] = data_.size();
+        data_.resize(data_.size() + PADDING, 0);
+        data_.shrink_to_fit();
+    }
+
+    void build(const std::vector<std::vector<int>>& lists) {
+        std::vector<uint64_t> start(lists.size() + 1, 0);
+        for (size_t v = 0; v < lists.size(); ++v) start[v + 1] = start[v] + lists[v].size();
+        std::vector<int> targets;
+        targets.reserve(start.back());
+        for (size_t v = 0; v < lists.size(); ++v) targets.insert(targets.end(), lists[v].begin(), lists[v].end());
+        build((int)lists.size(), start, targets);
+    }
+
+    // New lists (sorted, without duplicates) for some vertices; the other lists are copied as bytes
+    void replace(const std::map<int, std::vector<int>>& lists) {
+        if (lists.empty()) return;
+        std::vector<uint8_t> data;
+        data.reserve(data_.size());
+        std::vector<uint64_t> offsets(n_ + 1, 0);
+        std::map<int, std::vector<int>>::const_iterator next = lists.begin();
+        for (int v = 0; v < n_; ++v) {
+            offsets[v] = data.size();
+            if (next != lists.end() && next->first == v) {
+                ends_ += (long long)next->second.size() - degree_[v];
+                degree_[v] = next->second.size();
+                encodeList(next->second.data(), degree_[v], data);
+                ++next;
+            } else {
+                data.insert(data.end(), data_.begin() + offsets_[v], data_.begin() + offsets_[v + 1]);
+            }
+        }
+        offsets[n_] = data.size();
+        data.resize(data.size() + PADDING, 0);
+        maxDegree_ = n_ > 0 ? *std::max_element(degree_.begin(), degree_.end()) : 0;
+        data_.swap(data);
+        offsets_.swap(offsets);
+        data_.shrink_to_fit();
+    }
+
+    /*
+     * The neighbours of v into out, which must hold degree(v) + 3 ints
+     * (whole groups of 4 are written).
+     */
+    void decode(int v, int* out) const {
+        static const DecodeFunction function = chooseDecoder();
+        function(&data_[offsets_[v]], degree_[v], out);
+    }
+
+    std::vector<int> list(int v) const {
+        std::vector<int> out(degree_[v] + 3);
+        decode(v, out.data());
+        out.resize(degree_[v]);
+        return out;
+    }
+
+    void swap(CompressedAdjacency& o) {
+        std::swap(n_, o.n_);
+        std::swap(maxDegree_, o.maxDegree_);
+        std::swap(ends_, o.ends_);
+        offsets_.swap(o.offsets_);
+        degree_.swap(o.degree_);
+        data_.swap(o.data_);
+    }
+
+private:
+    // Decoding loads 4 bytes per gap (scalar) or 16 bytes per group (SSSE3) past the last one
+    static const size_t PADDING = 16;
+
+    typedef void (*DecodeFunction)(const uint8_t*, int, int*);
+
+    static void encodeList(const int* v, int degree, std::vector<uint8_t>& out) {
+        size_t control = out.size();
+        out.resize(out.size() + (degree + 3) / 4, 0);
+        uint32_t previous = UINT32_MAX;  // First gap: v[0] - (-1) - 1
+        for (int i = 0; i < degree; ++i) {
+            uint32_t gap = (uint32_t)v[i] - previous - 1;
+            previous = v[i];
+            int length = gap < (1u << 8) ? 1 : gap < (1u << 16) ? 2 : gap < (1u << 24) ? 3 : 4;
+            out[control + i / 4] |= (length - 1) << (2 * (i % 4));
+            for (int b = 0; b < length; ++b) out.push_back((uint8_t)(gap >> (8 * b)));
+        }
+    }
+
+    static uint32_t load32(const uint8_t* p) {
+        uint32_t x;
+        memcpy(&x, p, 4);
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        x = __builtin_bswap32(x);
+#endif
+        return x;
+    }
+
+    static const uint8_t* decodeGroup(const uint8_t* data, uint8_t control, int count,
+                                      uint32_t& previous, int* out) {
+        for (int k = 0; k < count; ++k) {
+            int length = ((control >> (2 * k)) & 3) + 1;
+            uint32_t gap = load32(data) & (UINT32_MAX >> (32 - 8 * length));
+            data += length;
+            previous += gap + 1;
+            out[k] = previous;
+        }
+        return data;
+    }
+
+    static void decodeScalar(const uint8_t* p, int degree, int* out) {
+        const uint8_t* control = p;
+        const uint8_t* data = p + (degree + 3) / 4;
+        uint32_t previous = UINT32_MAX;
+        for (int i = 0; i < degree; i += 4) {
+            data = decodeGroup(data, *control++, std::min(degree - i, 4), previous, out + i);
+        }
+    }
+
+#if defined(__x86_64__) && defined(__GNUC__)
+    struct ShuffleTables {
+        uint8_t shuffle[256][16];
+        uint8_t length[256];
+        ShuffleTables() {
+            for (int c = 0; c < 256; ++c) {
+                int offset = 0;
+                for (int k = 0; k < 4; ++k) {
+                    int bytes = ((c >> (2 * k)) & 3) + 1;
+                    for (int b = 0; b < 4; ++b) shuffle[c][4 * k + b] = b < bytes ? offset + b : 0x80;
+                    offset += bytes;
+                }
+                length[c] = offset;
+            }
+        }
+    };
+
+    __attribute__((target("ssse3")))
+    static void decodeSsse3(const uint8_t* p, int degree, int* out) {
+        static const ShuffleTables tables;
+        const uint8_t* control = p;
+        const uint8_t* data = p + (degree + 3) / 4;
+        const __m128i one = _mm_set1_epi32(1);
+        __m128i previous = _mm_set1_epi32(-1);
+        int i = 0;
+        for (; i + 4 <= degree; i += 4) {
+            uint8_t c = *control++;
+            __m128i gaps = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)data),
+                                            _mm_loadu_si128((const __m128i*)tables.shuffle[c]));
+            data += tables.length[c];
+            // v[k] = previous + sum_{j <= k} (gap[j] + 1)
+            __m128i x = _mm_add_epi32(gaps, one);
+            x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+            x = _mm_add_epi32(x, _mm_slli_si128(x, 8));
+            x = _mm_add_epi32(x, previous);
+            _mm_storeu_si128((__m128i*)(out + i), x);
+            previous = _mm_shuffle_epi32(x, 0xFF);
+        }
+        if (i < degree) {
+            uint32_t last = (uint32_t)_mm_cvtsi128_si32(previous);
+            decodeGroup(data, *control, degree - i, last, out + i);
+        }
+    }
+
+    static DecodeFunction chooseDecoder() {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("ssse3") ? decodeSsse3 : decodeScalar;
+    }
+#else
+    static DecodeFunction chooseDecoder() { return decodeScalar; }
+#endif
+
+    int n_;
+    int maxDegree_;
+    long long ends_;                  // Sum of the degrees
+    std::vector<uint64_t> offsets_;   // n + 1 byte offsets into data_
+    std::vector<int> degree_;
+    std::vector<uint8_t> data_;       // Encoded lists, then PADDING zero bytes
+};
+
+#endif
@@ -0,0 +1,80 @@
+/************************************************************
+     libpids.h - C API of the PIDS local branching solver
+ ***********************************************************/
+
+#ifndef LIBPIDS_H
+#define LIBPIDS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Embeddable version of lb_pids, built from localBranching.cpp with -DLIBPIDS
+ * (see README). Each context owns a graph, a parameter set and the best
+ * solution found so far. Different contexts can be solved concurrently from
+ * different threads; a single context must not be solved twice at once.
+ * Subproblems are solved by the external CPLEX binary (CPLEX_BIN), or in-process
+ * by the native branch-and-bound with the parameter "solveur" set to 1.
+ *
+ * Vertices are 0-based. Functions returning int return PIDS_OK or a negative
+ * error code; pids_last_error() describes the last failure of a context.
+ * The library writes nothing to stdout or stderr.
+ */
+
+#define PIDS_OK              0
+#define PIDS_ERR_ARGUMENT   -1
+#define PIDS_ERR_GRAPH      -2
+#define PIDS_ERR_BUSY       -3
+
+typedef struct pids_context pids_context;
+
+/* Called from the solving thread each time the incumbent improves */
+typedef void (*pids_improvement_cb)(const int* vertices, int count, void* user_data);
+
+pids_context* pids_create(void);
+void pids_destroy(pids_context* ctx);
+
+/* Graph from an edge list: edges[2*i], edges[2*i+1] for i < m */
+int pids_load_edges(pids_context* ctx, int n, const int* edges, int m);
+
+/* Graph from a buffer in an lb_pids input format: n, m, then the n x n adjacency matrix or m 1-based edges */
+int pids_load_buffer(pids_context* ctx, const char* data, size_t size);
+
+/*
+ * Parameters, named like the command-line flags: "t", "ti", "td", "a", "b", "k",
+ * "seed", "threads", "regions", "gap", "voisinage" (0-3), "lbc" (0-2), "adaptatif" (0/1),
+ * "rho" (threshold ceil(rho * deg), in (0, 1]), "solveur" (0 CPLEX, 1 native),
+ * "bnb_threads", "relinking" (elite size, 0 = off).
+ * A "seed" above 2^53 loses precision as a double: use pids_set_seed.
+ */
+int pids_set_param(pids_context* ctx, const char* name, double value);
+
+/* Seed of all random streams (any 64-bit value, 0 included); by default taken from the clock */
+int pids_set_seed(pids_context* ctx, uint64_t seed);
+
+/*
+ * Runs local branching in the calling thread until the time limit "t" or
+ * pids_cancel(). Returns the best score, or a negative error code.
+ */
+int pids_solve(pids_context* ctx, pids_improvement_cb callback, void* user_data);
+
+/* Asks a running pids_solve to stop after the current iteration; safe from any thread */
+void pids_cancel(pids_context* ctx);
+
+/*
+ * Copies the best solution so far (also during a solve) into vertices, at most
+ * capacity entries. Returns its size, or -1 if there is no solution yet.
+ */
+int pids_best_solution(pids_context* ctx, int* vertices, int capacity);
+
+const char* pids_last_error(const pids_context* ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
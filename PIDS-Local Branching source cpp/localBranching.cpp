@@ -15,12 +15,37 @@ using namespace std;
 #include <list>
 #include <set>
 #include <map>
+#include <queue>
 #include <iomanip>
 #include <algorithm>
 #include <limits>
 #include <random>
 #include <chrono>
 #include <ctime>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <cstdint>
+#include <mutex>
+#include <condition_variable>
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#endif
+#include "buffered_writer.h"
+#include "async_log.h"
+#include "compressed_adjacency.h"
+#include "pids_bnb.h"
+#include "libpids.h"
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/file.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <unistd.h>
+#endif
 // #include <ilcplex/ilocplex.h>
 
 // ILOSTLBEGIN
@@ -37,29 +62,396 @@ struct Solution {
 
 
 // Variables globales pour l'algorithme
-double temps_total_limit = 1800.0;
-double temps_intensification_limit = 500.0;
-double temps_diversification_limit = 100.0;
-double alpha = 0.3;  // 30% pour la perturbation
-double param_beta = 0.4;   // 40% pour la destruction
-int k = 20;           // Distance de Hamming pour le voisinage
-int age_limit = 10;
+// thread_local : chaque résolution a ses paramètres (voir ParametresPIDS) ; la ligne de
+// commande remplit ceux du thread principal, recopiés dans les workers
+thread_local double temps_total_limit = 1800.0;
+thread_local double temps_intensification_limit = 500.0;
+thread_local double temps_diversification_limit = 100.0;
+thread_local double alpha = 0.3;  // 30% pour la perturbation
+thread_local double param_beta = 0.4;   // 40% pour la destruction
+thread_local int k = 20;           // Distance de Hamming pour le voisinage
+thread_local int age_limit = 10;
 
 // AJOUTEZ CES 3 LIGNES ICI :
-bool warm_start = true;
-bool cplex_abort = false;
-bool heuristic_emphasis = false;
+thread_local bool warm_start = true;
+thread_local bool cplex_abort = false;          // Arrêter CPLEX à la première solution améliorante
+thread_local bool heuristic_emphasis = false;   // "set emphasis mip 5" par défaut dans les sous-problèmes
+
+// Sous-problèmes CPLEX : cutoff à incumbent - 1 et emphase par phase
+thread_local bool cutoff_incumbent = true;
+thread_local int emphase_intensification = -1;  // -1 : 5 si heuristic_emphasis, sinon 1
+thread_local int emphase_reparation = -1;       // Appel CPLEX sur une solution éloignée (distance > k)
+thread_local int emphase_exacte = 0;            // Mode -exact
+
+// Solveur des sous-problèmes : CPLEX externe ou branch-and-bound natif (pids_bnb.h)
+thread_local bool solveur_natif = false;
+thread_local int threads_bnb = 1;               // Threads du branch-and-bound natif par sous-problème
+
+// Décomposition en composantes connexes
+thread_local bool decomposition_composantes = false;
+thread_local int n_threads = 1;                 // Nombre de threads pour les grandes composantes
+thread_local int taille_max_exacte = 20;        // Composantes résolues par énumération exacte
+
+// Bornes inférieures
+thread_local double gap_cible = 0.0;            // Arrêt dès que (UB - LB) / UB <= gap_cible
+thread_local double periode_bornes = 10.0;      // Rafraîchissement des bornes (secondes)
+thread_local bool borne_lp_cplex = false;       // Calculer aussi la relaxation LP avec CPLEX
+thread_local bool bornes_actives = true;        // Faux sur les niveaux grossiers (-multiniveau) : pas des bornes du problème
+
+// Contrainte de local branching dans le sous-problème d'intensification
+enum ModeContrainteLB { LB_AUCUNE = 0, LB_AVEC_FIXATION = 1, LB_SEULE = 2 };
+thread_local int mode_contrainte_lb = LB_AUCUNE;
+thread_local int max_contraintes_inversees = 10;  // Boules déjà explorées gardées dans le modèle
+
+// Générateur de voisinage de l'intensification (voir generateurs_voisinage)
+thread_local int generateur_voisinage = 0;      // 0 = aléatoire
+
+// Intensification parallèle sur des régions disjointes (distance >= 3)
+thread_local int n_regions = 1;                 // 1 = un seul sous-problème par intensification
+
+// Contrôle adaptatif d'alpha, beta, k et des budgets -ti / -td (bandit UCB1)
+thread_local bool controle_adaptatif = false;
+
+// Path relinking entre solutions d'élite (voir phase_path_relinking) : taille de l'élite, 0 = désactivé
+thread_local int taille_elite = 0;
+
+// Valeurs d'alpha, beta et k utilisées par le thread : celles de la ligne de commande,
+// ou celles choisies par le contrôleur adaptatif (initialisées par algorithme_local_branching)
+thread_local double alpha_effectif = 0.3;
+thread_local double beta_effectif = 0.4;
+thread_local int k_effectif = 20;
+
+// Points de reprise (checkpoints) du local branching
+// Non recopié dans les workers : seul le thread principal écrit des points de reprise
+thread_local string fichier_point_reprise = "";
+thread_local double periode_point_reprise = 60.0;  // Secondes entre deux écritures
+
+// Adjacence en bitset pour les graphes denses (voir preparer_adjacence)
+enum ModeBits { BITS_AUTO = 0, BITS_OUI, BITS_NON };
+thread_local int mode_bits = BITS_AUTO;
+thread_local double densite_bits = 0.05;       // Seuil de densité du mode automatique
+
+// Seuils de domination h(v) = ceil(rho * d(v)), ou imposés sommet par sommet (-seuils)
+thread_local double rho = 0.5;
+thread_local vector<int> seuils_imposes;       // Indices du graphe du thread ; vide = politique rho
+
+// Renumérotation des sommets au chargement (voir calculer_ordre)
+// Non recopiée dans les workers : appliquée une fois par le thread principal
+enum OrdreSommets { ORDRE_AUCUN = 0, ORDRE_RCM, ORDRE_DEGRE, ORDRE_BFS, N_ORDRES };
+const char* noms_ordre[N_ORDRES] = { "aucun", "rcm", "degre", "bfs" };
+thread_local int ordre_renumerotation = ORDRE_AUCUN;
+
+// Mode combiné : résolution exacte du modèle complet après l'heuristique
+thread_local double temps_exact_limit = 0.0;    // 0 = désactivé
+
+// Mode multiniveau (voir resoudre_multiniveau) : contraction jusqu'à cette taille, 0 = désactivé
+// Non recopié dans les workers : seul le thread principal change de niveau
+thread_local int taille_multiniveau = 0;
+
+// Graine de toutes les suites aléatoires (-seed) ; sans -seed, tirée de l'horloge et affichée
+thread_local uint64_t graine_globale = 0;
+thread_local bool graine_donnee = false;        // Vrai si -seed (0 compris) a fixé graine_globale
 
 // Variables pour le graphe
-int n_sommets;
-vector<set<int>> voisins;
+// thread_local : chaque thread de résolution travaille sur son propre (sous-)graphe
+thread_local int n_sommets;
+thread_local CompressedAdjacency voisins;  // Listes triées compressées (compressed_adjacency.h)
+thread_local vector<int> seuils;   // h(v) du graphe du thread (preparer_graphe)
+thread_local uint64_t generation_graphe = 0;  // Change à chaque preparer_graphe (clé des caches par graphe)
 //vector<int> b, g;
 
+// Appelé à chaque amélioration de x_bar dans algorithme_local_branching (modes -serve, -coop)
+thread_local function<void(const Solution&)> rappel_amelioration;
+// Appelé au début de chaque itération : solution meilleure que le score donné trouvée ailleurs (-coop)
+thread_local function<bool(int, Solution&)> rappel_adoption;
+
+// Préfixe des fichiers temporaires CPLEX (un par thread pour éviter les collisions)
+thread_local string prefixe_fichiers_cplex = "";
+
+// Journal asynchrone (async_log.h) : une ligne par instruction, console et fichier OUTPUT
+// écrits par le thread du journal ; niveau choisi par -niveau (erreur, info, debug).
+// Bibliothèque (-DLIBPIDS) : rien sur la console du programme hôte
+#ifdef LIBPIDS
+#define CONSOLE_PIDS 0
+#else
+#define CONSOLE_PIDS LOG_CONSOLE
+#endif
+#define JOURNAL(fichier) PIDS_LOG(LOG_INFO, CONSOLE_PIDS | (fichier).mask())
+#define JOURNAL_CONSOLE PIDS_LOG(LOG_INFO, CONSOLE_PIDS)
+#define JOURNAL_DEBUG PIDS_LOG(LOG_DEBUG, CONSOLE_PIDS)
+#define JOURNAL_ERREUR PIDS_LOG(LOG_ERROR, CONSOLE_PIDS)
+
+/*
+ * Copie de tous les paramètres de résolution d'un thread : executer_en_parallele la
+ * transmet à ses workers, un contexte libpids l'installe dans le thread qui résout.
+ */
+struct ParametresPIDS {
+    double temps_total_limit;
+    double temps_intensification_limit;
+    double temps_diversification_limit;
+    double alpha;
+    double param_beta;
+    int k;
+    int age_limit;
+    bool warm_start;
+    bool cplex_abort;
+    bool heuristic_emphasis;
+    bool cutoff_incumbent;
+    int emphase_intensification;
+    int emphase_reparation;
+    int emphase_exacte;
+    bool solveur_natif;
+    int threads_bnb;
+    bool decomposition_composantes;
+    int n_threads;
+    int taille_max_exacte;
+    double gap_cible;
+    double periode_bornes;
+    bool borne_lp_cplex;
+    int mode_contrainte_lb;
+    int max_contraintes_inversees;
+    int generateur_voisinage;
+    int n_regions;
+    bool controle_adaptatif;
+    int taille_elite;
+    double periode_point_reprise;
+    double temps_exact_limit;
+    uint64_t graine_globale;
+    bool graine_donnee;
+    int mode_bits;
+    double densite_bits;
+    double rho;
+};
+
+ParametresPIDS capturer_parametres() {
+    ParametresPIDS p;
+    p.temps_total_limit = temps_total_limit;
+    p.temps_intensification_limit = temps_intensification_limit;
+    p.temps_diversification_limit = temps_diversification_limit;
+    p.alpha = alpha;
+    p.param_beta = param_beta;
+    p.k = k;
+    p.age_limit = age_limit;
+    p.warm_start = warm_start;
+    p.cplex_abort = cplex_abort;
+    p.heuristic_emphasis = heuristic_emphasis;
+    p.cutoff_incumbent = cutoff_incumbent;
+    p.emphase_intensification = emphase_intensification;
+    p.emphase_reparation = emphase_reparation;
+    p.emphase_exacte = emphase_exacte;
+    p.solveur_natif = solveur_natif;
+    p.threads_bnb = threads_bnb;
+    p.decomposition_composantes = decomposition_composantes;
+    p.n_threads = n_threads;
+    p.taille_max_exacte = taille_max_exacte;
+    p.gap_cible = gap_cible;
+    p.periode_bornes = periode_bornes;
+    p.borne_lp_cplex = borne_lp_cplex;
+    p.mode_contrainte_lb = mode_contrainte_lb;
+    p.max_contraintes_inversees = max_contraintes_inversees;
+    p.generateur_voisinage = generateur_voisinage;
+    p.n_regions = n_regions;
+    p.controle_adaptatif = controle_adaptatif;
+    p.taille_elite = taille_elite;
+    p.periode_point_reprise = periode_point_reprise;
+    p.temps_exact_limit = temps_exact_limit;
+    p.graine_globale = graine_globale;
+    p.graine_donnee = graine_donnee;
+    p.mode_bits = mode_bits;
+    p.densite_bits = densite_bits;
+    p.rho = rho;
+    return p;
+}
+
+void installer_parametres(const ParametresPIDS& p) {
+    temps_total_limit = p.temps_total_limit;
+    temps_intensification_limit = p.temps_intensification_limit;
+    temps_diversification_limit = p.temps_diversification_limit;
+    alpha = p.alpha;
+    param_beta = p.param_beta;
+    k = p.k;
+    age_limit = p.age_limit;
+    warm_start = p.warm_start;
+    cplex_abort = p.cplex_abort;
+    heuristic_emphasis = p.heuristic_emphasis;
+    cutoff_incumbent = p.cutoff_incumbent;
+    emphase_intensification = p.emphase_intensification;
+    emphase_reparation = p.emphase_reparation;
+    emphase_exacte = p.emphase_exacte;
+    solveur_natif = p.solveur_natif;
+    threads_bnb = p.threads_bnb;
+    decomposition_composantes = p.decomposition_composantes;
+    n_threads = p.n_threads;
+    taille_max_exacte = p.taille_max_exacte;
+    gap_cible = p.gap_cible;
+    periode_bornes = p.periode_bornes;
+    borne_lp_cplex = p.borne_lp_cplex;
+    mode_contrainte_lb = p.mode_contrainte_lb;
+    max_contraintes_inversees = p.max_contraintes_inversees;
+    generateur_voisinage = p.generateur_voisinage;
+    n_regions = p.n_regions;
+    controle_adaptatif = p.controle_adaptatif;
+    taille_elite = p.taille_elite;
+    periode_point_reprise = p.periode_point_reprise;
+    temps_exact_limit = p.temps_exact_limit;
+    graine_globale = p.graine_globale;
+    graine_donnee = p.graine_donnee;
+    mode_bits = p.mode_bits;
+    densite_bits = p.densite_bits;
+    rho = p.rho;
+}
+
+// Annulation coopérative (libpids) : vérifiée entre deux itérations, jamais pendant un appel CPLEX
+thread_local const atomic<bool>* jeton_annulation = NULL;
+
+bool annulation_demandee() {
+    return jeton_annulation && jeton_annulation->load();
+}
+
+/* Temps réel écoulé (en secondes) depuis un instant donné */
+double secondes_depuis(const chrono::steady_clock::time_point& debut) {
+    return chrono::duration<double>(chrono::steady_clock::now() - debut).count();
+}
+
+/*
+ * Pool de threads minimal : n_workers threads se partagent n_taches tâches
+ * (compteur atomique). Les tâches sont exécutées dans des threads dédiés,
+ * jamais dans le thread appelant, dont le graphe thread_local reste intact.
+ * Les workers reçoivent les paramètres et le jeton d'annulation de l'appelant.
+ */
+void executer_en_parallele(int n_taches, int n_workers, const function<void(int)>& tache) {
+    if (n_taches <= 0) return;
+    if (n_workers < 1) n_workers = 1;
+    if (n_workers > n_taches) n_workers = n_taches;
+
+    atomic<int> prochaine(0);
+    ParametresPIDS parametres = capturer_parametres();
+    const atomic<bool>* jeton = jeton_annulation;
+    vector<thread> workers;
+    for (int w = 0; w < n_workers; ++w) {
+        workers.emplace_back([&]() {
+            installer_parametres(parametres);
+            jeton_annulation = jeton;
+            int t;
+            while ((t = prochaine.fetch_add(1)) < n_taches) {
+                tache(t);
+            }
+        });
+    }
+    for (thread& th : workers) th.join();
+}
+
+/*
+ * Générateur aléatoire à compteur : le n-ième tirage vaut melange(cle + n * gamma)
+ * (fonction de sortie de SplitMix64). L'état tient en (cle, compteur), se sauvegarde
+ * tel quel et ne dépend d'aucun état global. derive(id) ouvre un flux indépendant :
+ * un par phase et par worker, déterminé par la graine et non par l'ordonnancement.
+ * Utilisable comme UniformRandomBitGenerator (uniform_real_distribution, ...).
+ */
+class FluxAleatoire {
+public:
+    typedef uint64_t result_type;
+
+    explicit FluxAleatoire(uint64_t cle = 0, uint64_t compteur = 0) : cle_(cle), compteur_(compteur) {}
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return numeric_limits<uint64_t>::max(); }
+
+    result_type operator()() {
+        return melange(cle_ + (++compteur_) * 0x9E3779B97F4A7C15ULL);
+    }
+
+    FluxAleatoire derive(uint64_t id) const {
+        return FluxAleatoire(melange(cle_ ^ melange(id + 0xD1B54A32D192ED03ULL)));
+    }
+
+    // Entier uniforme dans [0, n)
+    int entier(size_t n) {
+        return (int)(((unsigned __int128)(*this)() * n) >> 64);
+    }
+
+    // Réel uniforme dans [0, 1)
+    double uniforme() {
+        return ((*this)() >> 11) * 0x1.0p-53;
+    }
+
+    uint64_t cle() const { return cle_; }
+    uint64_t compteur() const { return compteur_; }
+
+    static uint64_t melange(uint64_t z) {
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+private:
+    uint64_t cle_;
+    uint64_t compteur_;
+};
+
+// Flux des phases (identifiants passés à derive)
+enum { FLUX_CONSTRUCTION = 1, FLUX_INTENSIFICATION = 2, FLUX_CONTRACTION = 3 };
+
+// Flux racine du thread : graine globale pour le thread principal, dérivé par tâche pour les workers
+thread_local FluxAleatoire flux_racine;
+// Flux du voisinage d'intensification (générateurs, régions), dérivé de flux_racine
+thread_local FluxAleatoire flux_intensification;
+
 
 
 //*******************************************************************
 //****************************************************************
 
+// ====================================================
+// TAMPONS DE TRAVAIL PAR THREAD
+// ====================================================
+
+/*
+ * Les tampons de taille n de la boucle de recherche (indicatrices, couverture,
+ * besoins, âges, files de parcours) appartiennent à l'arène du thread : ils sont
+ * dimensionnés au premier usage puis réutilisés, assign() sur une capacité
+ * suffisante ne réallouant pas. Une fonction qui emprunte un tampon n'appelle pas
+ * une autre fonction qui emprunte le même ; les emprunts sont notés en tête.
+ *
+ * Compilé avec -DPIDS_COMPTER_ALLOCATIONS (hors bibliothèque), operator new compte
+ * les allocations de chaque thread et le bilan par itération est affiché avec les
+ * statistiques du local branching.
+ */
+struct AreneTravail {
+    vector<char> dans_sol, marque, visite, domine;
+    vector<int> couverture, besoins, age, position, sommets, consideres, file, decodes;
+    vector<long long> fenwick;
+    vector<uint64_t> bits;
+};
+thread_local AreneTravail arene;
+
+#if defined(PIDS_COMPTER_ALLOCATIONS) && !defined(LIBPIDS)
+thread_local long long allocations_thread = 0;
+
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"  // GCC ne voit pas que new et delete sont remplacés ensemble
+void* operator new(size_t taille) {
+    allocations_thread++;
+    void* p = malloc(taille ? taille : 1);
+    if (!p) throw bad_alloc();
+    return p;
+}
+void operator delete(void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+#pragma GCC diagnostic pop
+
+long long compteur_allocations() { return allocations_thread; }
+#else
+long long compteur_allocations() { return -1; }  // Comptage désactivé
+#endif
+
+// Diversification : reconstructions mesurées (la première de chaque phase dimensionne les tampons)
+thread_local long long reconstructions_mesurees = 0;
+thread_local long long allocations_reconstructions = 0;
+
+
+
+
 // ====================================================
 // FONCTIONS DE CONVERSION MATRICE -> LISTE D'ARÊTES
 // ====================================================
@@ -74,7 +466,7 @@ bool convertir_matrice_vers_liste_aretes(const string& nom_fichier_entree) {
 
     ifstream fichier_in(nom_fichier_entree.c_str());
     if (!fichier_in) {
-        cout << "Erreur: impossible d'ouvrir le fichier " << nom_fichier_entree << endl;
+        JOURNAL_ERREUR << "Erreur: impossible d'ouvrir le fichier " << nom_fichier_entree;
         return false;
     }
 
@@ -103,7 +495,7 @@ bool convertir_matrice_vers_liste_aretes(const string& nom_fichier_entree) {
 
     // Vérifier que la matrice n'est pas vide
     if (matrice.empty()) {
-        cout << "Erreur: matrice vide" << endl;
+        JOURNAL_ERREUR << "Erreur: matrice vide";
         return false;
     }
 
@@ -112,15 +504,15 @@ bool convertir_matrice_vers_liste_aretes(const string& nom_fichier_entree) {
     // Vérifier que la matrice est carrée
     for (int i = 0; i < n_sommets; ++i) {
         if (matrice[i].size() != n_sommets) {
-            cout << "Erreur: la matrice n'est pas carrée (ligne " << i
-                 << " a " << matrice[i].size() << " éléments au lieu de "
-                 << n_sommets << ")" << endl;
+            JOURNAL_ERREUR << "Erreur: la matrice n'est pas carrée (ligne " << i
+                           << " a " << matrice[i].size() << " éléments au lieu de "
+                           << n_sommets << ")";
             return false;
         }
     }
 
     // Compter les arêtes (ne compter que la moitié supérieure pour éviter les doublons)
-    int n_aretes = 0;
+    long long n_aretes = 0;
     vector<pair<int, int>> aretes;
 
     for (int i = 0; i < n_sommets; ++i) {
@@ -139,7 +531,7 @@ bool convertir_matrice_vers_liste_aretes(const string& nom_fichier_entree) {
     // Écrire dans le fichier de sortie
     ofstream fichier_out(nom_sortie.c_str());
     if (!fichier_out) {
-        cout << "Erreur: impossible de créer le fichier " << nom_sortie << endl;
+        JOURNAL_ERREUR << "Erreur: impossible de créer le fichier " << nom_sortie;
         return false;
     }
 
@@ -155,13 +547,13 @@ bool convertir_matrice_vers_liste_aretes(const string& nom_fichier_entree) {
     fichier_out.close();
 
     // Afficher un résumé
-    cout << "========================================" << endl;
-    cout << "CONVERSION REUSSIE" << endl;
-    cout << "Fichier d'entrée  : " << nom_fichier_entree << endl;
-    cout << "Fichier de sortie : " << nom_sortie << endl;
-    cout << "Nombre de sommets : " << n_sommets << endl;
-    cout << "Nombre d'arêtes   : " << n_aretes << endl;
-    cout << "========================================" << endl;
+    JOURNAL_CONSOLE << "========================================";
+    JOURNAL_CONSOLE << "CONVERSION REUSSIE";
+    JOURNAL_CONSOLE << "Fichier d'entrée  : " << nom_fichier_entree;
+    JOURNAL_CONSOLE << "Fichier de sortie : " << nom_sortie;
+    JOURNAL_CONSOLE << "Nombre de sommets : " << n_sommets;
+    JOURNAL_CONSOLE << "Nombre d'arêtes   : " << n_aretes;
+    JOURNAL_CONSOLE << "========================================";
 
     return true;
 }
@@ -170,24 +562,60 @@ bool convertir_matrice_vers_liste_aretes(const string& nom_fichier_entree) {
  * Fonction pour afficher l'aide du programme
  */
 void afficher_aide() {
-    cout << "========================================" << endl;
-    cout << "LOCAL BRANCHING POUR PIDS" << endl;
-    cout << "========================================" << endl;
-    cout << "Usage :" << endl;
-    cout << "  ./lb_pids -i <fichier_liste_aretes> [options]" << endl;
-    cout << "     Exécute l'algorithme sur un fichier liste d'arêtes" << endl;
-    cout << endl;
-    cout << "  ./lb_pids -c <fichier_matrice>" << endl;
-    cout << "     Convertit une matrice d'adjacence en liste d'arêtes" << endl;
-    cout << endl;
-    cout << "Options :" << endl;
-    cout << "  -t  <double> : Temps total limite (defaut: 100.0)" << endl;
-    cout << "  -ti <double> : Temps intensification limite (defaut: 10.0)" << endl;
-    cout << "  -td <double> : Temps diversification limite (defaut: 10.0)" << endl;
-    cout << "  -a  <double> : Alpha (perturbation %) (defaut: 0.3)" << endl;
-    cout << "  -b  <double> : Beta (destruction %) (defaut: 0.4)" << endl;
-    cout << "  -k  <int>    : K (Distance Hamming) (defaut: 2)" << endl;
-    cout << "========================================" << endl;
+    ostringstream aide;
+    aide << "========================================" << endl;
+    aide << "LOCAL BRANCHING POUR PIDS" << endl;
+    aide << "========================================" << endl;
+    aide << "Usage :" << endl;
+    aide << "  ./lb_pids -i <fichier_liste_aretes> [options]" << endl;
+    aide << "     Exécute l'algorithme sur un fichier liste d'arêtes" << endl;
+    aide << endl;
+    aide << "  ./lb_pids -c <fichier_matrice>" << endl;
+    aide << "     Convertit une matrice d'adjacence en liste d'arêtes" << endl;
+    aide << endl;
+    aide << "Options :" << endl;
+    aide << "  -t  <double> : Temps total limite (defaut: 100.0)" << endl;
+    aide << "  -ti <double> : Temps intensification limite (defaut: 10.0)" << endl;
+    aide << "  -td <double> : Temps diversification limite (defaut: 10.0)" << endl;
+    aide << "  -a  <double> : Alpha (perturbation %) (defaut: 0.3)" << endl;
+    aide << "  -b  <double> : Beta (destruction %) (defaut: 0.4)" << endl;
+    aide << "  -k  <int>    : K (Distance Hamming) (defaut: 2)" << endl;
+    aide << "  -gap <double> : Arret des que le gap relatif est atteint (defaut: 0 = optimalite prouvee)" << endl;
+    aide << "  -pb  <double> : Periode de rafraichissement des bornes (defaut: 10.0)" << endl;
+    aide << "  -borne_lp    : Ajoute la relaxation LP (CPLEX) aux bornes" << endl;
+    aide << "  -exact <double> : Resolution exacte apres l'heuristique (MIP start + cutoff)" << endl;
+    aide << "  -solveur <cplex|natif> : Solveur des sous-problemes et de -exact (natif: branch-and-bound integre)" << endl;
+    aide << "  -bnb_threads <int> : Threads du branch-and-bound natif par sous-probleme (defaut: 1)" << endl;
+    aide << "  -lbc <aucune|avec|seule> : Contrainte de local branching dans l'intensification" << endl;
+    aide << "  -voisinage <aleatoire|bfs|partition|redondance> : Voisinage de l'intensification" << endl;
+    aide << "  -bits <auto|oui|non|seuil> : Adjacence en lignes de bits (auto: densite >= 0.05)" << endl;
+    aide << "  -rho <r> : Seuil de domination h(v) = ceil(r * deg(v)) (defaut 0.5)" << endl;
+    aide << "  -seuils <fichier> : Seuils h(v) imposes, un entier par sommet (remplace -rho)" << endl;
+    aide << "  -ordre <aucun|rcm|degre|bfs> : Renumerotation des sommets au chargement (localite memoire)" << endl;
+    aide << "  -bench_ordre <R>      : Mesure les noyaux de couverture pour chaque ordre (R passes) et quitte" << endl;
+    aide << "  -serve <socket>       : Mode serveur sur une socket Unix (graphes gardes en memoire)" << endl;
+    aide << "  -delta <fichier>      : Re-resolution incrementale apres modification d'aretes (+ u v / - u v)" << endl;
+    aide << "  -precedente <fichier> : Solution precedente pour -delta (OUTPUT_LocalBranching ou liste)" << endl;
+    aide << "  -graphe_maj <fichier> : Ecrire le graphe mis a jour par -delta" << endl;
+    aide << "  -seed <entier> : Graine des suites aleatoires (defaut: horloge, affichee au demarrage)" << endl;
+    aide << "  -checkpoint <fichier> : Point de reprise ecrit toutes les -pc secondes (defaut: 60)" << endl;
+    aide << "  --resume <fichier>    : Reprendre un run interrompu depuis son point de reprise" << endl;
+    aide << "  -adaptatif   : Ajuste alpha, beta, k et le partage -ti/-td en cours de route (bandit UCB1)" << endl;
+    aide << "  -regions <R> : Intensification sur R regions disjointes resolues en parallele (-threads)" << endl;
+    aide << "  -relinking <E> : Path relinking entre les E meilleures solutions variees (chemins sur -threads)" << endl;
+    aide << "  -abort       : Arret de CPLEX a la premiere solution ameliorante" << endl;
+    aide << "  -he          : Emphase heuristique (mip 5) dans les sous-problemes" << endl;
+    aide << "  -nocutoff    : Pas de cutoff a incumbent-1 dans les sous-problemes" << endl;
+    aide << "  -ei/-er/-ee <int> : Emphase MIP intensification / reparation / exacte" << endl;
+    aide << "  -cc          : Decomposition en composantes connexes" << endl;
+    aide << "  -cc_exact <int> : Taille max. des composantes resolues exactement (defaut: 20)" << endl;
+    aide << "  -threads <int>  : Threads pour les grandes composantes et les regions (defaut: 1)" << endl;
+    aide << "  -multiniveau <taille> : Contraction du graphe jusqu'a <taille> sommets, resolution puis raffinement" << endl;
+    aide << "  -niveau <erreur|info|debug> : Verbosite du journal (defaut: info)" << endl;
+    aide << "  -coop <nom>  : Recherche cooperative entre processus (memoire partagee /nom, ou socket:nom)" << endl;
+    aide << "  -coop_periode <double> : Periode de lecture de la solution commune par socket (defaut: 1.0)" << endl;
+    aide << "========================================" << endl;
+    AsyncLog::instance().writeConsole(aide.str());
 }
 
 //*************************************************************
@@ -198,38 +626,150 @@ void afficher_aide() {
 /* Fonction pour lire le graphe depuis un fichier txt */
 
 
-/* Fonction pour lire le graphe depuis un fichier txt */
-void lire_graphe(const string& nom_fichier, int& n_sommets,
-                 vector<set<int>>& voisins) {
+/*
+ * Graphe au format d'entrée depuis un tampon : n, m, puis soit la matrice
+ * d'adjacence n x n (0/1), soit m lignes "u v" numérotées à partir de 1 (format
+ * écrit par -c et -graphe_maj). Le format est reconnu à la première ligne après m.
+ * Deux passes (degrés, puis voisins) remplissent un CSR à offsets 64 bits, compressé
+ * ensuite : ni set ni liste par sommet, le pic mémoire est de 4 octets par extrémité
+ * d'arête avant compression.
+ */
+bool lire_graphe_tampon(const char* debut, const char* fin, int& n, CompressedAdjacency& graphe,
+                        string& erreur) {
+    const char* p = debut;
+    auto lire_entier = [&](long long& valeur) {
+        while (p < fin && isspace((unsigned char)*p)) ++p;
+        from_chars_result r = from_chars(p, fin, valeur);
+        if (r.ec != errc()) return false;
+        p = r.ptr;
+        return true;
+    };
 
-    ifstream fichier(nom_fichier.c_str());
+    long long n_lu, m;
+    if (!lire_entier(n_lu) || !lire_entier(m) || n_lu <= 0 || n_lu > numeric_limits<int>::max() || m < 0) {
+        erreur = "lecture de n et m impossible";
+        return false;
+    }
+    n = n_lu;
+
+    // Nombre d'entiers sur la première ligne de données : 2 pour une liste d'arêtes
+    while (p < fin && isspace((unsigned char)*p)) ++p;
+    const char* donnees = p;
+    int jetons = 0;
+    long long valeur, maximum = 0;
+    while (p < fin && *p != '\n') {
+        if (isspace((unsigned char)*p)) { ++p; continue; }
+        if (!lire_entier(valeur)) break;
+        jetons++;
+        maximum = max(maximum, valeur);
+    }
+    bool liste_aretes = (jetons == 0 && m == 0) || (jetons == 2 && !(n == 2 && maximum <= 1));
+
+    // Appelle f(u, v) pour chaque arête (indices à partir de 0, boucles ignorées)
+    auto parcourir = [&](auto f) {
+        p = donnees;
+        long long u, v, val;
+        if (liste_aretes) {
+            for (long long e = 0; e < m; ++e) {
+                if (!lire_entier(u) || !lire_entier(v) || u < 1 || v < 1 || u > n || v > n) {
+                    erreur = "arete " + to_string(e + 1) + " illisible ou hors de [1, n]";
+                    return false;
+                }
+                if (u != v) f(u - 1, v - 1);
+            }
+        } else {
+            for (int i = 0; i < n; ++i) {
+                for (int j = 0; j < n; ++j) {
+                    if (!lire_entier(val)) {
+                        erreur = "matrice d'adjacence incomplete";
+                        return false;
+                    }
+                    if (val == 1 && i != j) f(i, j);
+                }
+            }
+        }
+        return true;
+    };
+
+    vector<uint64_t> debut_adj(n + 1, 0);
+    if (!parcourir([&](int u, int v) { debut_adj[u + 1]++; debut_adj[v + 1]++; })) return false;
+    for (int i = 0; i < n; ++i) debut_adj[i + 1] += debut_adj[i];
+
+    vector<int> cibles(debut_adj[n]);
+    vector<uint64_t> position(debut_adj.begin(), debut_adj.end() - 1);
+    parcourir([&](int u, int v) {
+        cibles[position[u]++] = v;
+        cibles[position[v]++] = u;
+    });
+    graphe.build(n, debut_adj, cibles);  // Tri et doublons (matrice symétrique) par liste
+    return true;
+}
+
+/* Taille lisible pour le journal : Ko en dessous de 10 Mo, Mo au-delà */
+string taille_memoire(size_t octets) {
+    if (octets < (size_t)10 << 20) return to_string((octets + 512) >> 10) + " Ko";
+    return to_string((octets + (1 << 19)) >> 20) + " Mo";
+}
+
+/* Fichier projeté en mémoire (lu en entier sous Windows) puis lire_graphe_tampon ; false et erreur si illisible */
+bool charger_graphe(const string& nom_fichier, int& n, CompressedAdjacency& graphe, string& erreur) {
+    bool lu = false;
+#ifndef _WIN32
+    int fd = open(nom_fichier.c_str(), O_RDONLY);
+    struct stat st;
+    if (fd < 0 || fstat(fd, &st) != 0) {
+        if (fd >= 0) close(fd);
+        erreur = "fichier impossible a ouvrir";
+        return false;
+    }
+    if (st.st_size == 0) {
+        erreur = "fichier vide";
+    } else {
+        void* contenu = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (contenu == MAP_FAILED) {
+            erreur = "projection en memoire impossible";
+        } else {
+            madvise(contenu, st.st_size, MADV_SEQUENTIAL);
+            lu = lire_graphe_tampon((const char*)contenu, (const char*)contenu + st.st_size, n, graphe, erreur);
+            munmap(contenu, st.st_size);
+        }
+    }
+    close(fd);
+#else
+    ifstream fichier(nom_fichier.c_str(), ios::binary);
     if (!fichier) {
-        cout << "Erreur: fichier impossible a ouvrir" << endl;
-        exit(1);
+        erreur = "fichier impossible a ouvrir";
+        return false;
     }
+    string contenu((istreambuf_iterator<char>(fichier)), istreambuf_iterator<char>());
+    lu = lire_graphe_tampon(contenu.data(), contenu.data() + contenu.size(), n, graphe, erreur);
+#endif
+    return lu;
+}
 
-    int m_aretes;
-    // Read N and M (though we mostly need N and the matrix)
-    if (!(fichier >> n_sommets >> m_aretes)) {
-        cout << "Erreur de lecture de n et m" << endl;
+/* charger_graphe pour la ligne de commande : un graphe illisible arrête le programme */
+void lire_graphe(const string& nom_fichier, int& n_sommets, CompressedAdjacency& voisins) {
+    string erreur;
+    if (!charger_graphe(nom_fichier, n_sommets, voisins, erreur)) {
+        JOURNAL_ERREUR << "Erreur: " << nom_fichier << ": " << erreur;
         exit(1);
     }
+}
 
-    voisins = vector<set<int>>(n_sommets);
+/* Seuils imposés (-seuils) : un entier h(v) >= 0 par sommet, dans l'ordre du graphe */
+bool lire_seuils(const string& nom_fichier) {
+    ifstream fichier(nom_fichier.c_str());
+    if (!fichier.is_open()) return false;
 
-    // Read Adjacency Matrix
-    int val;
-    for (int i = 0; i < n_sommets; ++i) {
-        for (int j = 0; j < n_sommets; ++j) {
-            fichier >> val;
-            if (val == 1 && i != j) {
-                voisins[i].insert(j);
-                voisins[j].insert(i);
-            }
-        }
+    vector<int> lus;
+    int h;
+    while (fichier >> h) {
+        if (h < 0) return false;
+        lus.push_back(h);
     }
-
-    fichier.close();
+    if (!fichier.eof() || (int)lus.size() != n_sommets) return false;
+    seuils_imposes.swap(lus);
+    return true;
 }
 
 
@@ -280,63 +820,127 @@ string getCplexPath() {
 
 const string CPLEX_PATH = getCplexPath();
 
-void run_cplex(Solution& cpl_sol, Solution& best_sol, vector<int>& age, double r_limit) {
+/*
+ * Contrainte de distance de Hamming à une solution de référence x_bar (centre) :
+ *   Delta(x, x_bar) = sum_{i in S}(1 - x_i) + sum_{i not in S} x_i  <= rayon
+ * ou, une fois la boule explorée (contrainte inversée), Delta(x, x_bar) >= rayon.
+ */
+struct ContrainteDistance {
+    set<int> centre;
+    int rayon;
+    bool inversee;
+};
+
+// Tampon d'écriture des fichiers LP / MST, réutilisé d'un appel à l'autre
+thread_local BufferedWriter tampon_cplex;
+
+// Dernière ligne de statut MIP lue dans le log CPLEX (ex. "MIP - Integer optimal solution")
+thread_local string dernier_statut_cplex = "";
+
+/* Emphase effective d'une phase (-1 = valeur par défaut selon heuristic_emphasis) */
+int emphase_effective(int emphase) {
+    if (emphase >= 0) return emphase;
+    return heuristic_emphasis ? 5 : 1;
+}
+
+/* Cutoff pour n'accepter que des solutions strictement meilleures (objectif entier) */
+double cutoff_amelioration(const Solution& incumbent) {
+    return cutoff_incumbent ? incumbent.score - 1 : -1.0;
+}
+
+/*
+ * Le MIP start n'est donné que si le cutoff l'admet : avec incumbent - 1,
+ * CPLEX comme le B&B natif le rejetteraient à chaque appel.
+ */
+bool depart_admis(const Solution& depart, double cutoff) {
+    return warm_start && (cutoff <= 0 || depart.score <= cutoff);
+}
+
+/* Fichiers temporaires d'un sous-problème CPLEX (un jeu par préfixe) */
+struct FichiersCplex {
+    string lp, mst, script, log;
+};
+
+FichiersCplex fichiers_cplex(const string& prefixe) {
+    FichiersCplex f;
+    f.mst = tmpPath(prefixe + "start.mst");
+    f.lp = tmpPath(prefixe + "subproblem.lp");
+    f.script = prefixe + "script_sub.txt";
+    f.log = prefixe + "cplex_sub.log";
+    return f;
+}
+
+/*
+ * Écriture du MIP start, du modèle LP et du script CPLEX d'un sous-problème.
+ * Lit le graphe du thread appelant.
+ *
+ * cutoff > 0     : les noeuds de valeur supérieure sont élagués (set mip tolerances uppercutoff)
+ * emphase        : valeur de "set emphasis mip"
+ * arret_premiere : arrêt à la première solution trouvée autre que le MIP start
+ * Le MIP start (best_sol) n'est écrit que si depart_admis.
+ */
+bool ecrire_sous_probleme(const FichiersCplex& fichiers, const Solution& best_sol, const vector<int>& age,
+                          double r_limit, double cutoff, int emphase, bool arret_premiere,
+                          const vector<ContrainteDistance>* distances) {
     // 0. Generate MST file (Warm Start)
-    if (warm_start) {
-        ofstream mstFile("start.mst");
-        if (mstFile) {
-            mstFile << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>" << endl;
-            mstFile << "<CPLEXSolutions>" << endl;
-            mstFile << " <CPLEXSolution version=\"1.0\">" << endl;
-            mstFile << "  <header/>" << endl;
-            mstFile << "  <variables>" << endl;
-            
-            for (int i = 0; i < n_sommets; ++i) {
-                // If strict compatibility is required:
-                // Only provide value if it doesn't conflict with age (fixed to 0)
-                // However, CPLEX can usually handle partial or repairing. 
-                // Let's provide 1s for vertices in best_sol, unless fixed to 0.
-                
-                if (age[i] == -1) {
-                    mstFile << "   <variable name=\"x" << (i+1) << "\" value=\"0\"/>" << endl;
-                } else {
-                    if (best_sol.vertices.find(i) != best_sol.vertices.end()) {
-                        mstFile << "   <variable name=\"x" << (i+1) << "\" value=\"1\"/>" << endl;
-                    } else {
-                        mstFile << "   <variable name=\"x" << (i+1) << "\" value=\"0\"/>" << endl;
-                    }
-                }
-            }
-            
-            mstFile << "  </variables>" << endl;
-            mstFile << " </CPLEXSolution>" << endl;
-            mstFile << "</CPLEXSolutions>" << endl;
-            mstFile.close();
+    const string& mstFilename = fichiers.mst;
+    const string& lpFilename = fichiers.lp;
+    const string& scriptFilename = fichiers.script;
+
+    BufferedWriter& out = tampon_cplex;
+    bool avec_depart = depart_admis(best_sol, cutoff);
+
+    if (avec_depart && out.open(mstFilename)) {
+        out.put("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                "<CPLEXSolutions>\n"
+                " <CPLEXSolution version=\"1.0\">\n"
+                "  <header/>\n"
+                "  <variables>\n");
+
+        for (int i = 0; i < n_sommets; ++i) {
+            // Provide 1s for vertices in best_sol, unless fixed to 0 (age -1).
+            bool un = (age[i] != -1) && best_sol.vertices.find(i) != best_sol.vertices.end();
+            out.put("   <variable name=\"").putVar(i).put(un ? "\" value=\"1\"/>\n" : "\" value=\"0\"/>\n");
         }
+
+        out.put("  </variables>\n"
+                " </CPLEXSolution>\n"
+                "</CPLEXSolutions>\n");
+        if (!out.close()) { JOURNAL_ERREUR << "Error writing MST file"; return false; }
     }
 
     // 1. Generate LP file
-    string lpFilename = "subproblem.lp";
-    ofstream lpFile(lpFilename.c_str());
-    if (!lpFile) { cout << "Error creating LP file" << endl; return; }
+    if (!out.open(lpFilename)) { JOURNAL_ERREUR << "Error creating LP file"; return false; }
 
-    lpFile << "Minimize" << endl << " obj: ";
+    out.put("Minimize\n obj: ");
     for (int i = 0; i < n_sommets; ++i) {
-        lpFile << "x" << (i+1);
-        if (i < n_sommets-1) lpFile << " + ";
+        out.putVar(i);
+        if (i < n_sommets-1) out.put(" + ");
     }
-    lpFile << endl << "Subject To" << endl;
+    out.put("\nSubject To\n");
 
     // Constraints
     for (int i = 0; i < n_sommets; ++i) {
-        double rhs_val = ceil(voisins[i].size() * 0.5);
-        int rhs = (int)rhs_val;
+        int rhs = seuils[i];
 
-        lpFile << " c" << (i+1) << ": ";
-        for (set<int>::iterator sit = voisins[i].begin(); sit != voisins[i].end(); ++sit) {
-            lpFile << "x" << (*sit + 1) << " + ";
+        out.put(" c").putInt(i+1).put(": ");
+        for (int v : voisins[i]) {
+            out.putVar(v).put(" + ");
+        }
+        out.putInt(rhs).put(' ').putVar(i).put(" >= ").putInt(rhs).put('\n');
+    }
+
+    // Local branching constraints: Delta(x, centre) <= rayon (or >= rayon once reversed),
+    // written as sum_{i not in S} x_i - sum_{i in S} x_i  <=/>=  rayon - |S|
+    if (distances) {
+        for (size_t c = 0; c < distances->size(); ++c) {
+            const ContrainteDistance& d = (*distances)[c];
+            out.put(" lb").putInt(c+1).put(":");
+            for (int i = 0; i < n_sommets; ++i) {
+                out.put(d.centre.count(i) ? " - " : " + ").putVar(i);
+            }
+            out.put(d.inversee ? " >= " : " <= ").putInt(d.rayon - (long long)d.centre.size()).put('\n');
         }
-        lpFile << rhs << " x" << (i+1) << " >= " << rhs << endl; 
     }
     
     // Fixing variables based on age
@@ -344,70 +948,87 @@ void run_cplex(Solution& cpl_sol, Solution& best_sol, vector<int>& age, double r
     // If age is 1, fix to 1 (Keep / Lower Bound = 1)
     // If age is 0, free (Binary)
     
-    lpFile << "Bounds" << endl;
+    out.put("Bounds\n");
     for (int i = 0; i < n_sommets; ++i) {
         if (age[i] == -1) {
-            lpFile << " x" << (i+1) << " = 0" << endl;
+            out.put(' ').putVar(i).put(" = 0\n");
         } else if (age[i] == 1) {
-             lpFile << " x" << (i+1) << " = 1" << endl;
+            out.put(' ').putVar(i).put(" = 1\n");
         } else {
-             lpFile << " 0 <= x" << (i+1) << " <= 1" << endl;
+            out.put(" 0 <= ").putVar(i).put(" <= 1\n");
         }
     }
 
-    lpFile << "Binaries" << endl;
-    for (int i=0; i<n_sommets; ++i) lpFile << " x" << (i+1) << endl;
-    lpFile << "End" << endl;
-    lpFile.close();
+    out.put("Binaries\n");
+    for (int i=0; i<n_sommets; ++i) out.put(' ').putVar(i).put('\n');
+    out.put("End\n");
+    if (!out.close()) { JOURNAL_ERREUR << "Error writing LP file"; return false; }
 
     // 2. Generate Script
-    ofstream script("script_sub.txt");
+    ofstream script(scriptFilename.c_str());
     script << "read " << lpFilename << endl;
-    if (warm_start) {
-        script << "read start.mst" << endl;
+    if (avec_depart) {
+        script << "read " << mstFilename << endl;
     }
     script << "set timelimit " << r_limit << endl;
-    script << "set emphasis mip 1" << endl; // Feasibility emphasis
+    script << "set emphasis mip " << emphase << endl; // 1 = Feasibility emphasis
+    if (cutoff > 0) {
+        script << "set mip tolerances uppercutoff " << cutoff << endl;
+    }
+    if (arret_premiere) {
+        // Le MIP start accepté compte comme première solution
+        script << "set mip limits solutions " << (avec_depart ? 2 : 1) << endl;
+    }
     script << "optimize" << endl;
     script << "display solution variables -" << endl;
     script << "quit" << endl;
     script.close();
+    return true;
+}
 
+/*
+ * Lancement de CPLEX sur un sous-problème déjà écrit et lecture des variables à 1.
+ * N'accède pas au graphe : peut s'exécuter dans n'importe quel thread.
+ * Retourne false si le log ne contient pas de solution.
+ */
+bool resoudre_sous_probleme(const FichiersCplex& fichiers, vector<int>& sol_vars, string& statut) {
     // 3. Run CPLEX
-    string cmd = CPLEX_PATH + " -f script_sub.txt > cplex_sub.log";
+    const string& logFilename = fichiers.log;
+    string cmd = CPLEX_PATH + " -f " + fichiers.script + " > " + logFilename + " 2>&1";
     int ret = system(cmd.c_str());
     if (ret != 0) {
-        cout << "DEBUG: CPLEX command failed with return code " << ret << endl;
+        JOURNAL_DEBUG << "CPLEX command failed with return code " << ret;
     } else {
-        cout << "DEBUG: CPLEX run completed. Checking log..." << endl;
+        JOURNAL_DEBUG << "CPLEX run completed. Checking log...";
     }
 
     // 4. Parse Output
-    cpl_sol.score = std::numeric_limits<int>::max(); // Default to infinite/invalid
-    cpl_sol.vertices.clear();
-
-    ifstream log("cplex_sub.log");
+    ifstream log(logFilename.c_str());
     string line;
     bool readingSol = false;
     bool foundHeaders = false;
-    vector<int> sol_vars;
+    sol_vars.clear();
+    statut = "";
     
     // DEBUG: Read first few lines of log to verify content
     /*
     ifstream debug_log("cplex_sub.log");
     string debug_line;
     int debug_count = 0;
-    cout << "--- CPLEX LOG START ---" << endl;
+    JOURNAL_CONSOLE << "--- CPLEX LOG START ---";
     while(getline(debug_log, debug_line) && debug_count < 5) {
-        cout << debug_line << endl;
+        JOURNAL_CONSOLE << debug_line;
         debug_count++;
     }
-    cout << "--- CPLEX LOG END ---" << endl;
+    JOURNAL_CONSOLE << "--- CPLEX LOG END ---";
     debug_log.close();
     */
     
     if (log.is_open()) {
         while(getline(log, line)) {
+             if (line.find("MIP - ") != string::npos) {
+                 statut = line.substr(line.find("MIP - "));
+             }
              if (line.find("Variable Name") != string::npos) {
                  readingSol = true;
                  foundHeaders = true;
@@ -436,20 +1057,118 @@ void run_cplex(Solution& cpl_sol, Solution& best_sol, vector<int>& age, double r
         }
         log.close();
     } else {
-        cout << "DEBUG: Could not open cplex_sub.log!" << endl;
+        JOURNAL_ERREUR << "Could not open " << logFilename << "!";
+    }
+
+    JOURNAL_DEBUG << "Parsed " << sol_vars.size() << " variables from CPLEX output.";
+    return foundHeaders;
+}
+
+/*
+ * Le même sous-problème pour le branch-and-bound natif (pids_bnb.h) : mêmes fixations
+ * (age -1 : 0, age 1 : 1) et contraintes de distance que ecrire_sous_probleme, passées
+ * en mémoire au lieu d'un fichier LP. Lit le graphe du thread appelant.
+ */
+PidsModel modele_sous_probleme(const vector<int>& age, const vector<ContrainteDistance>* distances) {
+    PidsModel modele;
+    modele.n = n_sommets;
+    modele.start.resize(n_sommets + 1);
+    modele.targets.reserve(2 * voisins.edges());
+    modele.fixed.resize(n_sommets);
+    for (int i = 0; i < n_sommets; ++i) {
+        for (int v : voisins[i]) modele.targets.push_back(v);
+        modele.start[i + 1] = modele.targets.size();
+        modele.fixed[i] = age[i] == -1 ? 0 : age[i] == 1 ? 1 : -1;
+    }
+    modele.threshold = seuils;
+    if (distances) {
+        for (const ContrainteDistance& d : *distances) {
+            PidsModel::Distance distance;
+            distance.centre.assign(n_sommets, 0);
+            for (int v : d.centre) distance.centre[v] = 1;
+            distance.radius = d.rayon;
+            distance.reversed = d.inversee;
+            modele.distances.push_back(distance);
+        }
+    }
+    return modele;
+}
+
+/*
+ * Résolution d'un modèle par le branch-and-bound natif, avec la sémantique des
+ * paramètres CPLEX de ecrire_sous_probleme (cutoff, arrêt à la première solution).
+ * Le statut reprend les lignes "MIP - ..." du log CPLEX, lues par
+ * mettre_a_jour_contrainte_lb. N'accède pas au graphe : peut s'exécuter dans
+ * n'importe quel thread. Retourne false s'il n'y a pas de solution.
+ */
+bool resoudre_modele_natif(const PidsModel& modele, const vector<char>* depart, double r_limit, double cutoff,
+                           bool arret_premiere, int threads, const atomic<bool>* annulation,
+                           vector<int>& sol_vars, string& statut) {
+    chrono::steady_clock::time_point debut = chrono::steady_clock::now();
+    PidsBranchAndBound bnb(modele);
+    PidsBnbOptions options;
+    options.timeLimit = r_limit;
+    options.threads = threads;
+    options.upper = cutoff > 0 ? (int)floor(cutoff + 1e-9) : INT_MAX;
+    options.stopAtFirst = arret_premiere;
+    options.start = depart;
+    options.cancel = annulation;
+    PidsBnbResult resultat = bnb.solve(options);
+
+    switch (resultat.status) {
+        case PidsBnbResult::OPTIMAL: statut = "MIP - Integer optimal solution"; break;
+        case PidsBnbResult::INFEASIBLE: statut = "MIP - Integer infeasible."; break;
+        case PidsBnbResult::FEASIBLE:
+            statut = arret_premiere ? "MIP - Solution limit exceeded, integer feasible."
+                                    : "MIP - Time limit exceeded, integer feasible.";
+            break;
+        default: statut = "MIP - Time limit exceeded, no integer solution."; break;
     }
+    JOURNAL_DEBUG << "B&B natif: " << bnb.freeVariables() << " variables libres, " << bnb.constraints()
+                  << " contraintes, " << resultat.nodes << " noeuds en " << 1000.0 * secondes_depuis(debut)
+                  << " ms (" << statut << ")";
+
+    sol_vars = resultat.selected;
+    return resultat.value != INT_MAX;
+}
+
+/* Sous-problème complet (écriture, résolution, lecture) avec les paramètres de ecrire_sous_probleme */
+void run_cplex(Solution& cpl_sol, const Solution& best_sol, vector<int>& age, double r_limit,
+               double cutoff = -1.0, int emphase = 1, bool arret_premiere = false,
+               const vector<ContrainteDistance>* distances = NULL) {
+    vector<int> sol_vars;
+    bool foundHeaders;
+    if (solveur_natif) {
+        vector<char> depart(n_sommets, 0);
+        for (int v : best_sol.vertices) depart[v] = 1;
+        PidsModel modele = modele_sous_probleme(age, distances);
+        cpl_sol.score = std::numeric_limits<int>::max();
+        cpl_sol.vertices.clear();
+        foundHeaders = resoudre_modele_natif(modele, depart_admis(best_sol, cutoff) ? &depart : NULL, r_limit, cutoff,
+                                             arret_premiere, threads_bnb, jeton_annulation, sol_vars, dernier_statut_cplex);
+    } else {
+        FichiersCplex fichiers = fichiers_cplex(prefixe_fichiers_cplex);
+        if (!ecrire_sous_probleme(fichiers, best_sol, age, r_limit, cutoff, emphase, arret_premiere, distances)) {
+            return;
+        }
+
+        cpl_sol.score = std::numeric_limits<int>::max(); // Default to infinite/invalid
+        cpl_sol.vertices.clear();
 
-    cout << "DEBUG: Parsed " << sol_vars.size() << " variables from CPLEX output." << endl;
+        foundHeaders = resoudre_sous_probleme(fichiers, sol_vars, dernier_statut_cplex);
+    }
 
     // Only update solution if we actually found the variables section
     if (foundHeaders) {
         cpl_sol.score = 0;
-        for (int i=0; i<n_sommets; ++i) {
-            bool is_one = false; 
-            for(size_t k=0; k<sol_vars.size(); ++k) {
-                 if(sol_vars[k]==i) { is_one=true; break; }
+        vector<char>& un = arene.marque;
+        un.assign(n_sommets, 0);
+        for (int v : sol_vars) {
+            if (v >= 0 && v < n_sommets) un[v] = 1;
         }
-            
+        for (int i=0; i<n_sommets; ++i) {
+            bool is_one = un[i];
+
             if (age[i] >= 0) {
                 age[i]++;
                 if (is_one) {
@@ -460,14 +1179,20 @@ void run_cplex(Solution& cpl_sol, Solution& best_sol, vector<int>& age, double r
                 if (age[i] >= age_limit) age[i] = -1;
             }
         }
-        cout << "solution cplex " << cpl_sol.score << endl;
+        JOURNAL_DEBUG << "solution cplex " << cpl_sol.score;
     } else {
         // Fallback: CPLEX failed (infeasible or validation failed or time limit reached without solution)
         // We incorrectly told the user it's logic to return the initial solution if no better one found.
         // Returning the 'best_sol' (which was our warm start) is a safe fallback for the ALGORITHM flow,
         // effectively meaning "no improvement".
         
-        cout << "solution cplex FAILED (using previous best: " << best_sol.score << ")" << endl;
+        if (cutoff > 0) {
+            // Avec le cutoff, l'absence de solution signifie "pas d'amélioration trouvée"
+            JOURNAL_DEBUG << "solution cplex: aucune amelioration sous le cutoff " << cutoff
+                          << " (" << dernier_statut_cplex << ")";
+        } else {
+            JOURNAL_CONSOLE << "solution cplex FAILED (using previous best: " << best_sol.score << ")";
+        }
         cpl_sol = best_sol; // Copy previous best
     }
 }
@@ -512,9 +1237,8 @@ bool est_domine(int sommet, const Solution& solution) {
         return true;
     }
 
-    // Sinon, il doit avoir au moins la moitié de ses voisins dans la solution
-    int total_voisins = voisins[sommet].size();
-    int seuil = ceil(total_voisins * 0.5);  // Au moins la moitié arrondie à l'entier supérieur
+    // Sinon, il doit avoir au moins h(v) voisins dans la solution (la moitié arrondie pour rho = 0.5)
+    int seuil = seuils[sommet];
 
     int compteur = 0;
     for (int voisin : voisins[sommet]) {
@@ -533,6 +1257,240 @@ bool est_domine(int sommet, const Solution& solution) {
 
 
 
+// ====================================================
+// ADJACENCE EN BITSET (GRAPHES DENSES)
+// ====================================================
+
+/*
+ * Sur un graphe dense, les listes de voisins coûtent plus cher à parcourir qu'une
+ * ligne de bits : le nombre de voisins d'un sommet dans la solution devient
+ * popcount(ligne ET solution), calculé par blocs AVX-512 (VPOPCNTDQ), AVX2
+ * (table de 4 bits et PSADBW) ou en scalaire selon le processeur. Les voisins
+ * restent dans voisins ; les lignes de bits en sont une copie, reconstruite par
+ * preparer_graphe() chaque fois que le graphe du thread change.
+ */
+struct AdjacenceBits {
+    int n;
+    int mots;                  // Mots de 64 bits par ligne (multiple de 8)
+    vector<uint64_t> lignes;
+};
+thread_local AdjacenceBits adjacence_bits;
+
+typedef int (*NoyauPopcount)(const uint64_t*, const uint64_t*, int);
+
+int popcount_et_scalaire(const uint64_t* a, const uint64_t* b, int mots) {
+    int compte = 0;
+    for (int i = 0; i < mots; ++i) compte += __builtin_popcountll(a[i] & b[i]);
+    return compte;
+}
+
+#if defined(__x86_64__) && defined(__GNUC__)
+__attribute__((target("avx2")))
+int popcount_et_avx2(const uint64_t* a, const uint64_t* b, int mots) {
+    const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                           0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i quartet = _mm256_set1_epi8(0x0f);
+    __m256i total = _mm256_setzero_si256();
+    int i = 0;
+    for (; i + 4 <= mots; i += 4) {
+        __m256i v = _mm256_and_si256(_mm256_loadu_si256((const __m256i*)(a + i)),
+                                     _mm256_loadu_si256((const __m256i*)(b + i)));
+        __m256i bas = _mm256_shuffle_epi8(table, _mm256_and_si256(v, quartet));
+        __m256i haut = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), quartet));
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(_mm256_add_epi8(bas, haut), _mm256_setzero_si256()));
+    }
+    int compte = _mm256_extract_epi64(total, 0) + _mm256_extract_epi64(total, 1) +
+                 _mm256_extract_epi64(total, 2) + _mm256_extract_epi64(total, 3);
+    return compte + popcount_et_scalaire(a + i, b + i, mots - i);
+}
+
+__attribute__((target("avx512f,avx512vpopcntdq")))
+int popcount_et_avx512(const uint64_t* a, const uint64_t* b, int mots) {
+    __m512i total = _mm512_setzero_si512();
+    int i = 0;
+    for (; i + 8 <= mots; i += 8) {
+        __m512i v = _mm512_and_si512(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i));
+        total = _mm512_add_epi64(total, _mm512_popcnt_epi64(v));
+    }
+    alignas(64) long long partiels[8];
+    _mm512_store_si512(partiels, total);
+    int compte = 0;
+    for (int j = 0; j < 8; ++j) compte += partiels[j];
+    return compte + popcount_et_scalaire(a + i, b + i, mots - i);
+}
+#endif
+
+NoyauPopcount choisir_noyau_popcount() {
+#if defined(__x86_64__) && defined(__GNUC__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512vpopcntdq")) return popcount_et_avx512;
+    if (__builtin_cpu_supports("avx2")) return popcount_et_avx2;
+#endif
+    return popcount_et_scalaire;
+}
+
+const NoyauPopcount popcount_et = choisir_noyau_popcount();
+
+bool bits_actifs() {
+    return n_sommets > 0 && adjacence_bits.n == n_sommets && !adjacence_bits.lignes.empty();
+}
+
+/* Choisit la représentation pour le graphe du thread (-bits) et construit les lignes si besoin */
+void preparer_adjacence() {
+    long long somme_degres = 0;
+    for (int i = 0; i < n_sommets; ++i) somme_degres += voisins[i].size();
+    double densite = n_sommets > 1 ? somme_degres / ((double)n_sommets * (n_sommets - 1)) : 0.0;
+
+    bool utiliser = mode_bits == BITS_OUI || (mode_bits == BITS_AUTO && densite >= densite_bits);
+    if (!utiliser || n_sommets == 0) {
+        adjacence_bits.n = 0;
+        adjacence_bits.lignes.clear();
+        adjacence_bits.lignes.shrink_to_fit();
+        return;
+    }
+
+    adjacence_bits.n = n_sommets;
+    adjacence_bits.mots = ((n_sommets + 63) / 64 + 7) / 8 * 8;
+    adjacence_bits.lignes.assign((size_t)n_sommets * adjacence_bits.mots, 0);
+    for (int i = 0; i < n_sommets; ++i) {
+        uint64_t* ligne = &adjacence_bits.lignes[(size_t)i * adjacence_bits.mots];
+        for (int u : voisins[i]) ligne[u >> 6] |= 1ULL << (u & 63);
+    }
+}
+
+// ====================================================
+// SEUILS ET NOYAUX DE COUVERTURE
+// ====================================================
+
+/*
+ * Les boucles sur tout le graphe (couverture, réalisabilité) sont écrites une
+ * fois, en templates sur :
+ *  - la vue du graphe : VueEnsembles (listes de voisins, décodées par blocs
+ *    dans arene.decodes) ou VueBits (lignes de bits), qui donne couverts(v) = |N(v) ∩ S| ;
+ *  - la politique de seuil : SeuilMoitie (rho = 0.5, calcul entier sans table)
+ *    ou SeuilTable (seuils précalculés : rho quelconque ou -seuils).
+ * avec_noyau() choisit l'instanciation une fois par appel ; les boucles
+ * internes n'ont plus de test de représentation ni de flottant.
+ */
+
+/* h(v) pour un degré d : ceil(rho * d), sans l'erreur d'arrondi de rho * d (0.55 * 100 > 55) */
+int seuil_rho(int d) {
+    return (int)ceil(rho * d - 1e-9);
+}
+
+/* Recalcule seuils pour le graphe du thread ; seuils_imposes n'est pris que s'il lui correspond */
+void calculer_seuils() {
+    bool imposes = (int)seuils_imposes.size() == n_sommets;
+    seuils.resize(n_sommets);
+    for (int v = 0; v < n_sommets; ++v) {
+        seuils[v] = imposes ? seuils_imposes[v] : seuil_rho(voisins[v].size());
+    }
+}
+
+bool politique_moitie() {
+    return rho == 0.5 && (int)seuils_imposes.size() != n_sommets;
+}
+
+/* À appeler chaque fois que le graphe du thread change */
+void preparer_graphe() {
+    static atomic<uint64_t> compteur_generations(0);
+    generation_graphe = ++compteur_generations;  // Unique entre threads : jamais 0
+    calculer_seuils();
+    preparer_adjacence();
+}
+
+struct SeuilMoitie {
+    int operator()(int v) const { return ((int)voisins[v].size() + 1) >> 1; }
+};
+
+struct SeuilTable {
+    const int* h;
+    int operator()(int v) const { return h[v]; }
+};
+
+struct VueEnsembles {
+    const char* dans_sol;
+    int* tampon;  // degré max + 3 entiers
+    int couverts(int v) const {
+        voisins.decode(v, tampon);
+        int d = voisins.degree(v), compte = 0;
+        for (int i = 0; i < d; ++i) compte += dans_sol[tampon[i]];
+        return compte;
+    }
+};
+
+struct VueBits {
+    const uint64_t* bits;
+    int couverts(int v) const {
+        return popcount_et(&adjacence_bits.lignes[(size_t)v * adjacence_bits.mots], bits, adjacence_bits.mots);
+    }
+};
+
+template <class Vue>
+void compter_couverture(const Vue& g, int* couverture) {
+    for (int v = 0; v < n_sommets; ++v) couverture[v] = g.couverts(v);
+}
+
+template <class Vue, class Seuil>
+void marquer_domines(const Vue& g, const Seuil& h, const char* dans_sol, char* domine) {
+    for (int v = 0; v < n_sommets; ++v) domine[v] = dans_sol[v] || g.couverts(v) >= h(v);
+}
+
+template <class Vue, class Seuil>
+bool tous_domines(const Vue& g, const Seuil& h, const char* dans_sol) {
+    for (int v = 0; v < n_sommets; ++v) {
+        if (!dans_sol[v] && g.couverts(v) < h(v)) return false;
+    }
+    return true;
+}
+
+/* Appelle f(vue, seuil) avec la représentation et la politique du graphe du thread (emprunte arene.bits ou arene.decodes) */
+template <class F>
+auto avec_noyau(const vector<char>& dans_sol, F f) {
+    if (bits_actifs()) {
+        vector<uint64_t>& bits = arene.bits;
+        bits.assign(adjacence_bits.mots, 0);
+        for (int v = 0; v < n_sommets; ++v) {
+            if (dans_sol[v]) bits[v >> 6] |= 1ULL << (v & 63);
+        }
+        VueBits g = { bits.data() };
+        return politique_moitie() ? f(g, SeuilMoitie()) : f(g, SeuilTable{ seuils.data() });
+    }
+    arene.decodes.resize(voisins.maxDegree() + 3);
+    VueEnsembles g = { dans_sol.data(), arene.decodes.data() };
+    return politique_moitie() ? f(g, SeuilMoitie()) : f(g, SeuilTable{ seuils.data() });
+}
+
+vector<char> indicatrice_ensemble(const set<int>& S) {
+    vector<char> dans_sol(n_sommets, 0);
+    for (int v : S) dans_sol[v] = 1;
+    return dans_sol;
+}
+
+/* domine[v] pour l'indicatrice dans_sol, sans allocation une fois domine dimensionné */
+void marquer_sommets_domines(const vector<char>& dans_sol, vector<char>& domine) {
+    domine.resize(n_sommets);
+    avec_noyau(dans_sol, [&](const auto& g, const auto& h) {
+        marquer_domines(g, h, dans_sol.data(), domine.data());
+        return 0;
+    });
+}
+
+/* Tous les sommets sont-ils dominés par l'indicatrice dans_sol ? */
+bool indicatrice_realisable(const vector<char>& dans_sol) {
+    return avec_noyau(dans_sol, [&](const auto& g, const auto& h) {
+        return tous_domines(g, h, dans_sol.data());
+    });
+}
+
+/* Tous les sommets sont-ils dominés ? */
+bool solution_realisable(const Solution& solution) {
+    return indicatrice_realisable(indicatrice_ensemble(solution.vertices));
+}
+
+
+
+
 /* Fonction pour calculer le score d'une solution */
 int calculer_score(const Solution& solution) {
     int score = 0;
@@ -542,13 +1500,15 @@ int calculer_score(const Solution& solution) {
     return score;
 }
 
-/* Fonction pour supprimer aléatoirement un pourcentage des sommets */
-set<int> supprimer_pourcentage(const Solution& solution, double pourcentage,
-                              default_random_engine& generator,
-                              uniform_real_distribution<double>& distribution) {
+/* Fonction pour supprimer aléatoirement un pourcentage des sommets : supprime[v] = 1 (emprunte arene.sommets) */
+void supprimer_pourcentage(const Solution& solution, double pourcentage,
+                           FluxAleatoire& generator,
+                           uniform_real_distribution<double>& distribution,
+                           vector<char>& supprime) {
 
-    set<int> sommets_supprimes;
-    vector<int> sommets_solution(solution.vertices.begin(), solution.vertices.end());
+    supprime.assign(n_sommets, 0);
+    vector<int>& sommets_solution = arene.sommets;
+    sommets_solution.assign(solution.vertices.begin(), solution.vertices.end());
 
     int n_a_supprimer = static_cast<int>(sommets_solution.size() * pourcentage);
     if (n_a_supprimer == 0 && !sommets_solution.empty()) {
@@ -560,33 +1520,52 @@ set<int> supprimer_pourcentage(const Solution& solution, double pourcentage,
         int idx = static_cast<int>(r * sommets_solution.size());
         if (idx == sommets_solution.size()) idx = sommets_solution.size() - 1;
 
-        sommets_supprimes.insert(sommets_solution[idx]);
+        supprime[sommets_solution[idx]] = 1;
         sommets_solution.erase(sommets_solution.begin() + idx);
     }
-
-    return sommets_supprimes;
 }
 
 /* Heuristique de roulette pour générer une solution initiale */
 
 
 /* Heuristique de roulette pour générer une solution initiale */
-Solution heuristique_roulette_exacte(int n_sommets, vector<set<int>>& voisins,
-                                     default_random_engine& generator,
+Solution heuristique_roulette_exacte(int n_sommets, const CompressedAdjacency& voisins,
+                                     FluxAleatoire& generator,
                                      uniform_real_distribution<double>& distribution) {
 
     Solution x0;
     x0.score = 0;
 
-    // Ensemble des sommets non encore dominés
-    set<int> C;
-    for (int i = 0; i < n_sommets; ++i) {
-        C.insert(i);
+    // Ensemble C des sommets non encore dominés : indicatrice et arbre de Fenwick
+    // (k-ième sommet de C en O(log n), comme l'ancien parcours d'un set<int>)
+    vector<char> dans_C(n_sommets, 1);
+    int taille_C = n_sommets;
+    vector<int> fenwick(n_sommets + 1, 0);
+    for (int i = 1; i <= n_sommets; ++i) {
+        fenwick[i]++;
+        int parent = i + (i & -i);
+        if (parent <= n_sommets) fenwick[parent] += fenwick[i];
     }
+    auto retirer_de_C = [&](int v) {
+        if (!dans_C[v]) return;
+        dans_C[v] = 0;
+        taille_C--;
+        for (int i = v + 1; i <= n_sommets; i += i & -i) fenwick[i]--;
+    };
+    auto kieme_de_C = [&](int k) {  // k à partir de 0
+        int pos = 0;
+        for (int pas = 1 << 30; pas > 0; pas >>= 1) {
+            if (pos + pas <= n_sommets && fenwick[pos + pas] <= k) {
+                pos += pas;
+                k -= fenwick[pos];
+            }
+        }
+        return pos;
+    };
 
     // Calculer les degrés pour la roulette
     vector<int> deg_G(n_sommets, 0);
-    int somme_degres = 0;
+    long long somme_degres = 0;
 
     for (int i = 0; i < n_sommets; ++i) {
         deg_G[i] = voisins[i].size();
@@ -631,22 +1610,22 @@ Solution heuristique_roulette_exacte(int n_sommets, vector<set<int>>& voisins,
     }
 
     // Pour chaque sommet, stocker combien de voisins doivent être dans la solution
-    // si le sommet n'est pas dans la solution (besoin = ceil(deg(i)/2))
-    vector<int> besoins(n_sommets, 0);
-    for (int i = 0; i < n_sommets; ++i) {
-        besoins[i] = ceil(voisins[i].size() * 0.5);
-    }
+    // si le sommet n'est pas dans la solution (besoin = h(i))
+    vector<int> besoins = seuils;
+    long long non_domines = 0;  // Sommets de besoin non nul
+    for (int i = 0; i < n_sommets; ++i) non_domines += besoins[i] > 0;
 
-    while (!C.empty()) {
+    while (taille_C > 0) {
         double p_r = distribution(generator);
 
-        // Sélectionner un sommet avec la roulette
+        // Sélectionner un sommet avec la roulette : dernier intervalle commençant avant p_r
+        // (recherche dichotomique ; les intervalles vides, en tête à égalité de début, sont sautés)
         int sommet_selectionne = -1;
-        for (int i = 0; i < n_sommets; ++i) {
-            if (intervalles[i].first <= p_r && p_r < intervalles[i].second) {
-                sommet_selectionne = sommets_tries[i].first;
-                break;
-            }
+        vector<pair<double, double>>::iterator it =
+            upper_bound(intervalles.begin(), intervalles.end(), p_r,
+                        [](double x, const pair<double, double>& intervalle) { return x < intervalle.first; });
+        if (it != intervalles.begin() && p_r < (it - 1)->second) {
+            sommet_selectionne = sommets_tries[it - 1 - intervalles.begin()].first;
         }
 
         // Si pas trouvé (peut arriver à cause d'erreurs d'arrondi)
@@ -655,17 +1634,12 @@ Solution heuristique_roulette_exacte(int n_sommets, vector<set<int>>& voisins,
         }
 
         // Si le sommet sélectionné n'est plus dans C, en prendre un aléatoire
-        if (C.find(sommet_selectionne) == C.end()) {
-            if (!C.empty()) {
-                double r = distribution(generator);
-                int pos = static_cast<int>(r * C.size());
-                if (pos == C.size()) pos = C.size() - 1;
-
-                auto it = C.begin();
-                advance(it, pos);
-                sommet_selectionne = *it;
-            }
-        }
+        if (!dans_C[sommet_selectionne]) {
+            double r = distribution(generator);
+            int pos = static_cast<int>(r * taille_C);
+            if (pos == taille_C) pos = taille_C - 1;
+            sommet_selectionne = kieme_de_C(pos);
+        }
 
         if (sommet_selectionne == -1) break;
 
@@ -675,97 +1649,256 @@ Solution heuristique_roulette_exacte(int n_sommets, vector<set<int>>& voisins,
 
         // Mettre à jour les besoins
         // Si le sommet est dans la solution, il est dominé
+        if (besoins[sommet_selectionne] > 0) non_domines--;
         besoins[sommet_selectionne] = 0;
 
         // Pour chaque voisin, réduire son besoin de 1
         for (int voisin : voisins[sommet_selectionne]) {
             if (besoins[voisin] > 0) {
                 besoins[voisin]--;
+                if (besoins[voisin] == 0) non_domines--;
             }
         }
 
-        // Mettre à jour l'ensemble C (sommets non encore dominés)
-        set<int> nouveaux_domines;
+        // Retirer de C le sommet sélectionné et les voisins devenus dominés
+        retirer_de_C(sommet_selectionne);
+        for (int voisin : voisins[sommet_selectionne]) {
+            if (besoins[voisin] == 0) retirer_de_C(voisin);
+        }
 
-        // Vérifier si le sommet sélectionné est maintenant dominé
-        if (besoins[sommet_selectionne] == 0) {
-            nouveaux_domines.insert(sommet_selectionne);
+        // Tous les sommets sont-ils dominés ?
+        if (non_domines == 0) {
+            break;
         }
+    }
 
-        // Vérifier les voisins
-        for (int voisin : voisins[sommet_selectionne]) {
-            if (besoins[voisin] == 0) {
-                nouveaux_domines.insert(voisin);
-            }
+    return x0;
+}
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+
+// ====================================================
+// BORNES INFÉRIEURES ET ARRÊT SUR GAP
+// ====================================================
+
+struct BornesInferieures {
+    int degre;                 // Borne combinatoire sur les degrés
+    double lagrange;           // Meilleure valeur du dual lagrangien
+    double relaxation_lp;      // Relaxation continue (CPLEX), -1 si non calculée
+    int meilleure;             // max des bornes, arrondie à l'entier supérieur
+    vector<double> lambda;     // Multiplicateurs (repris à chaque rafraîchissement)
+    double mu;                 // Facteur de pas du sous-gradient
+
+    BornesInferieures() : degre(0), lagrange(0.0), relaxation_lp(-1.0), meilleure(0), mu(2.0) {}
+};
+
+/*
+ * Borne sur les degrés : pour v hors de S, |N(v) ∩ S| >= h(v) (ceil(d(v)/2) pour rho = 0.5).
+ * En sommant : sum_{v} h(v) <= sum_{u in S} (d(u) + h(u)). Le plus petit nombre
+ * de sommets dont les plus grandes valeurs d(u) + h(u) atteignent sum h(v)
+ * minore donc |S|.
+ */
+int borne_degres() {
+    long long besoin_total = 0;
+    vector<int> poids(n_sommets);
+    for (int i = 0; i < n_sommets; ++i) {
+        int d = voisins[i].size();
+        int h = seuils[i];
+        besoin_total += h;
+        poids[i] = d + h;
+    }
+    sort(poids.begin(), poids.end(), greater<int>());
+
+    long long cumul = 0;
+    int borne = 0;
+    while (cumul < besoin_total && borne < n_sommets) {
+        cumul += poids[borne];
+        borne++;
+    }
+    return borne;
+}
+
+/*
+ * Dual lagrangien : toutes les contraintes sum_{j in N(i)} x_j + h_i x_i >= h_i
+ * sont relâchées avec des multiplicateurs lambda_i >= 0, optimisés par
+ * sous-gradient (pas de Polyak vers la borne supérieure borne_sup).
+ * Retourne la meilleure valeur obtenue pendant ces n_iter itérations.
+ */
+double borne_lagrangienne(BornesInferieures& b, int borne_sup, int n_iter) {
+    const vector<int>& h = seuils;
+    if ((int)b.lambda.size() != n_sommets) b.lambda.assign(n_sommets, 0.0);
+
+    vector<double> cout_reduit(n_sommets);
+    vector<char> x(n_sommets);
+    vector<double> g(n_sommets);
+    double meilleure_valeur = b.lagrange;
+    int sans_progres = 0;
+
+    for (int it = 0; it < n_iter; ++it) {
+        // Sous-problème : x_j = 1 ssi son coût réduit est négatif
+        double valeur = 0.0;
+        for (int j = 0; j < n_sommets; ++j) {
+            double c = 1.0 - b.lambda[j] * h[j];
+            for (int i : voisins[j]) c -= b.lambda[i];
+            cout_reduit[j] = c;
+            x[j] = (c < 0.0);
+            if (x[j]) valeur += c;
+            valeur += b.lambda[j] * h[j];
         }
 
-        // Retirer les sommets dominés de C
-        C.erase(sommet_selectionne);
-        for (int sommet : nouveaux_domines) {
-            C.erase(sommet);
+        if (valeur > meilleure_valeur + 1e-9) {
+            meilleure_valeur = valeur;
+            sans_progres = 0;
+        } else if (++sans_progres >= 20) {
+            b.mu *= 0.5;
+            sans_progres = 0;
         }
+        if (b.mu < 1e-4 || meilleure_valeur > borne_sup - 1.0 + 1e-6) break;
 
-        // Vérifier si tous les sommets sont dominés
-        bool tous_domines = true;
+        // Sous-gradient
+        double norme = 0.0;
         for (int i = 0; i < n_sommets; ++i) {
-            if (besoins[i] > 0) {
-                tous_domines = false;
-                break;
-            }
+            int couverture = 0;
+            for (int j : voisins[i]) couverture += x[j];
+            g[i] = h[i] - couverture - (x[i] ? h[i] : 0);
+            if (b.lambda[i] <= 0.0 && g[i] < 0.0) g[i] = 0.0;  // Projection
+            norme += g[i] * g[i];
         }
+        if (norme < 1e-12) break;  // x réalisable : la borne ne progressera plus
 
-        if (tous_domines) {
-            break;
+        double pas = b.mu * (borne_sup - valeur) / norme;
+        for (int i = 0; i < n_sommets; ++i) {
+            b.lambda[i] = max(0.0, b.lambda[i] + pas * g[i]);
         }
     }
 
-    return x0;
+    return meilleure_valeur;
 }
 
+/* Relaxation continue du modèle de run_cplex, résolue par CPLEX (-1 en cas d'échec) */
+double borne_relaxation_lp(double r_limit) {
+    string lpFilename = tmpPath(prefixe_fichiers_cplex + "relaxation.lp");
+    string scriptFilename = prefixe_fichiers_cplex + "script_relaxation.txt";
+    string logFilename = prefixe_fichiers_cplex + "cplex_relaxation.log";
 
+    BufferedWriter& out = tampon_cplex;
+    if (!out.open(lpFilename)) return -1.0;
 
+    out.put("Minimize\n obj: ");
+    for (int i = 0; i < n_sommets; ++i) {
+        out.putVar(i);
+        if (i < n_sommets-1) out.put(" + ");
+    }
+    out.put("\nSubject To\n");
+    for (int i = 0; i < n_sommets; ++i) {
+        int rhs = seuils[i];
+        out.put(" c").putInt(i+1).put(": ");
+        for (int v : voisins[i]) out.putVar(v).put(" + ");
+        out.putInt(rhs).put(' ').putVar(i).put(" >= ").putInt(rhs).put('\n');
+    }
+    // Pas de section Binaries : CPLEX résout le problème continu
+    out.put("Bounds\n");
+    for (int i = 0; i < n_sommets; ++i) out.put(" 0 <= ").putVar(i).put(" <= 1\n");
+    out.put("End\n");
+    if (!out.close()) return -1.0;
 
+    ofstream script(scriptFilename.c_str());
+    script << "read " << lpFilename << endl;
+    script << "set timelimit " << r_limit << endl;
+    script << "optimize" << endl;
+    script << "quit" << endl;
+    script.close();
 
+    string cmd = CPLEX_PATH + " -f " + scriptFilename + " > " + logFilename + " 2>&1";
+    if (system(cmd.c_str()) != 0) return -1.0;
 
+    ifstream log(logFilename.c_str());
+    string line;
+    double objectif = -1.0;
+    while (getline(log, line)) {
+        size_t pos = line.find("Objective =");
+        if (pos != string::npos && line.find("Optimal") != string::npos) {
+            objectif = atof(line.c_str() + pos + 11);
+        }
+    }
+    return objectif;
+}
 
+/* Fonction pour (re)calculer les bornes ; la relaxation LP n'est résolue qu'une fois */
+void rafraichir_bornes(BornesInferieures& b, int borne_sup, bool premier_appel) {
+    if (premier_appel) {
+        b.degre = borne_degres();
+        if (borne_lp_cplex) b.relaxation_lp = borne_relaxation_lp(temps_intensification_limit);
+    }
+    b.lagrange = borne_lagrangienne(b, borne_sup, premier_appel ? 200 : 50);
 
+    double meilleure = max((double)b.degre, max(b.lagrange, b.relaxation_lp));
+    b.meilleure = (int)ceil(meilleure - 1e-6);
+}
 
+/* Gap relatif entre la solution courante et la meilleure borne inférieure */
+double calculer_gap(int borne_sup, const BornesInferieures& b) {
+    if (borne_sup <= 0) return 0.0;
+    return max(0.0, double(borne_sup - b.meilleure) / borne_sup);
+}
 
+/* Affiche la borne et le gap */
+void afficher_bornes(LogFile& logFile, int borne_sup, const BornesInferieures& b) {
+    ostringstream oss;
+    oss << "Borne inferieure: " << b.meilleure << " (degres " << b.degre
+        << ", lagrange " << fixed << setprecision(2) << b.lagrange;
+    if (b.relaxation_lp >= 0.0) oss << ", LP " << b.relaxation_lp;
+    oss << ") - gap " << setprecision(2) << 100.0 * calculer_gap(borne_sup, b) << "%";
 
+    JOURNAL(logFile) << oss.str();
+}
 
 
 
 
 
-/* Phase d'intensification */
-
-/* Phase d'intensification utilisant run_cplex avec Alpha controlé */
-Solution phase_intensification_avec_run_cplex(Solution solution_courante, double temps_limit) {
-
-    clock_t debut = clock();
-    Solution meilleure_solution = solution_courante;
-
-    // 1. Définir l'espace de recherche (voisinage)
-    vector<int> age(n_sommets, -1);  // -1 = sommet fixé à 0, 0 = sommet libre (binaire)
 
+// ====================================================
+// GÉNÉRATEURS DE VOISINAGE POUR L'INTENSIFICATION
+// ====================================================
 
+/*
+ * Un générateur remplit age pour le sous-problème : 0 = libre, 1 = fixé à 1,
+ * -1 = fixé à 0. Les générateurs par région libèrent une zone connexe du graphe
+ * (les contraintes y interagissent, un échange améliorant y est possible) et
+ * fixent tous les autres sommets à leur valeur dans la solution courante.
+ */
+typedef void (*GenerateurVoisinage)(const Solution&, vector<int>&);
 
+/* Voisinage aléatoire : alpha % de la solution et alpha % des autres sommets libérés */
+void voisinage_aleatoire(const Solution& solution_courante, vector<int>& age) {
     // A. Traitement des sommets de la solution : Sélectionner EXACTEMENT alpha % à détruire
-    vector<int> sommets_sol;
-    for (int v : solution_courante.vertices) {
-        sommets_sol.push_back(v);
-    }
+    vector<int>& sommets_sol = arene.sommets;
+    sommets_sol.assign(solution_courante.vertices.begin(), solution_courante.vertices.end());
 
     // Mélanger aléatoirement les indices
-    // Utilisation de rand() pour le mélange simple
+    // Mélange de Fisher-Yates sur le flux d'intensification
     for (size_t i = 0; i < sommets_sol.size(); ++i) {
-        size_t j = i + rand() % (sommets_sol.size() - i);
+        size_t j = i + flux_intensification.entier(sommets_sol.size() - i);
         swap(sommets_sol[i], sommets_sol[j]);
     }
 
     // Calculer le nombre de sommets à détruire (libérer)
-    int n_a_detruire = (int)(sommets_sol.size() * alpha);
-    
+    int n_a_detruire = (int)(sommets_sol.size() * alpha_effectif);
+
     // Les premiers n_a_detruire sont mis à 0 (Libre), les autres à 1 (Fixé)
     int n_fixed = 0;
     int n_free = 0;
@@ -779,314 +1912,3077 @@ Solution phase_intensification_avec_run_cplex(Solution solution_courante, double
             n_fixed++;
         }
     }
-    cout << "DEBUG: Alpha=" << alpha << " Total Sol=" << sommets_sol.size() 
-         << " Destroyed(Free)=" << n_free << " Kept(Fixed)=" << n_fixed << endl;
+    JOURNAL_DEBUG << "Alpha=" << alpha_effectif << " Total Sol=" << sommets_sol.size()
+                  << " Destroyed(Free)=" << n_free << " Kept(Fixed)=" << n_fixed;
 
     // B. Traitement des sommets HORS solution
     // On garde l'approche probabiliste pour l'expansion, ou on peut faire pareil
     // Ici, on garde l'approche probabiliste comme avant pour l'expansion
     for (int i = 0; i < n_sommets; ++i) {
         if (solution_courante.vertices.find(i) == solution_courante.vertices.end()) {
-             double r = ((double) rand() / (RAND_MAX));
-             if (r < alpha) {
+             double r = flux_intensification.uniforme();
+             if (r < alpha_effectif) {
                  age[i] = 0; // Libre (Expansion)
              } else {
                  age[i] = -1; // Fixé à 0 (Exclu)
              }
         }
     }
+}
 
-    // 2. Appeler CPLEX sur ce sous-problème
-    Solution solution_cplex;
-    double temps_restant = temps_limit;
-    
-    // Solution de référence pour le warm-start
-    Solution reference_solution = solution_courante;
+/* Nombre de sommets libérés par une région (même budget que le voisinage aléatoire) */
+int taille_region() {
+    return max(1, (int)(alpha_effectif * n_sommets));
+}
 
-    run_cplex(solution_cplex, reference_solution, age, temps_restant);
+/* Couverture de chaque sommet : nombre de voisins dans la solution */
+void calculer_couverture(const vector<char>& dans_sol, vector<int>& couverture) {
+    couverture.resize(n_sommets);
+    avec_noyau(dans_sol, [&](const auto& g, const auto&) {
+        compter_couverture(g, couverture.data());
+        return 0;
+    });
+}
 
-    // 3. Vérifier et retourner
-    bool solution_valide = true;
-    for (int i = 0; i < n_sommets; ++i) {
-        if (!est_domine(i, solution_cplex)) {
-            solution_valide = false;
-            break;
+void indicatrice_solution(const Solution& solution, vector<char>& dans_sol) {
+    dans_sol.assign(n_sommets, 0);
+    for (int v : solution.vertices) dans_sol[v] = 1;
+}
+
+/* Retire de sol les candidats redondants : dominés sans eux, sans faire perdre la domination d'un voisin */
+void retirer_redondants(const vector<int>& candidats, vector<char>& dans_sol, vector<int>& couverture,
+                        Solution& sol) {
+    for (int u : candidats) {
+        if (!dans_sol[u]) continue;
+        if (couverture[u] < seuils[u]) continue;
+        bool retirable = true;
+        for (int w : voisins[u]) {
+            if (!dans_sol[w] && couverture[w] - 1 < seuils[w]) {
+                retirable = false;
+                break;
+            }
+        }
+        if (retirable) {
+            dans_sol[u] = 0;
+            sol.vertices.erase(u);
+            for (int w : voisins[u]) couverture[w]--;
         }
     }
+}
+
+/*
+ * Libère une région connexe de cible sommets par parcours en largeur depuis graine.
+ * Si etiquettes est fourni, les sommets de la même classe que la graine sont
+ * visités en priorité (la région remplit d'abord le cluster). Si la composante
+ * est épuisée, le parcours repart d'un sommet aléatoire.
+ * La file à deux bouts est un tableau de 2n + 1 cases partant du milieu : chaque
+ * sommet y entre au plus une fois, par l'avant ou par l'arrière (emprunte
+ * arene.visite et arene.file).
+ */
+void liberer_region(int graine, int cible, const vector<char>& dans_sol, vector<int>& age,
+                    const vector<int>* etiquettes) {
+    for (int i = 0; i < n_sommets; ++i) age[i] = dans_sol[i] ? 1 : -1;
+
+    vector<char>& visite = arene.visite;
+    visite.assign(n_sommets, 0);
+    vector<int>& file = arene.file;
+    file.resize(2 * n_sommets + 1);
+    int tete = n_sommets, queue = n_sommets;
+    int liberes = 0;
+
+    while (liberes < cible && liberes < n_sommets) {
+        if (tete == queue) {
+            if (visite[graine]) {
+                graine = flux_intensification.entier(n_sommets);
+                if (visite[graine]) continue;
+            }
+            visite[graine] = 1;
+            file[queue++] = graine;
+        }
+
+        int v = file[tete++];
+        age[v] = 0;
+        liberes++;
+
+        for (int u : voisins[v]) {
+            if (visite[u]) continue;
+            visite[u] = 1;
+            if (etiquettes && (*etiquettes)[u] == (*etiquettes)[graine]) file[--tete] = u;
+            else file[queue++] = u;
+        }
+    }
+}
+
+/* Voisinage BFS : boule autour d'un sommet à faible marge (contrainte presque serrée) */
+void voisinage_bfs(const Solution& solution_courante, vector<int>& age) {
+    vector<char>& dans_sol = arene.dans_sol;
+    vector<int>& couverture = arene.couverture;
+    indicatrice_solution(solution_courante, dans_sol);
+    calculer_couverture(dans_sol, couverture);
+
+    // Tournoi : parmi quelques sommets hors solution tirés au hasard, la plus faible marge
+    int graine = flux_intensification.entier(n_sommets);
+    int meilleure_marge = numeric_limits<int>::max();
+    for (int essai = 0; essai < 16; ++essai) {
+        int v = flux_intensification.entier(n_sommets);
+        if (dans_sol[v]) continue;
+        int marge = couverture[v] - seuils[v];
+        if (marge < meilleure_marge) {
+            meilleure_marge = marge;
+            graine = v;
+        }
+    }
+
+    liberer_region(graine, taille_region(), dans_sol, age, NULL);
+}
 
-    if (solution_valide && solution_cplex.score < meilleure_solution.score) {
-        return solution_cplex;
+/* Voisinage redondance : boule autour d'un sommet de la solution entouré de sommets sur-couverts */
+void voisinage_redondance(const Solution& solution_courante, vector<int>& age) {
+    vector<char>& dans_sol = arene.dans_sol;
+    vector<int>& couverture = arene.couverture;
+    indicatrice_solution(solution_courante, dans_sol);
+    calculer_couverture(dans_sol, couverture);
+    vector<int>& sommets_sol = arene.sommets;
+    sommets_sol.assign(solution_courante.vertices.begin(), solution_courante.vertices.end());
+
+    if (sommets_sol.empty()) {
+        voisinage_bfs(solution_courante, age);
+        return;
     }
 
-    return meilleure_solution;
+    // Redondance de u : marge moyenne des sommets de N[u] hors solution si u était retiré
+    int graine = sommets_sol[flux_intensification.entier(sommets_sol.size())];
+    double meilleure_redondance = -numeric_limits<double>::max();
+    for (int essai = 0; essai < 16; ++essai) {
+        int u = sommets_sol[flux_intensification.entier(sommets_sol.size())];
+        double redondance = couverture[u] - seuils[u];
+        for (int v : voisins[u]) {
+            if (!dans_sol[v]) redondance += couverture[v] - 1 - seuils[v];
+        }
+        redondance /= (voisins[u].size() + 1);
+        if (redondance > meilleure_redondance) {
+            meilleure_redondance = redondance;
+            graine = u;
+        }
+    }
+
+    liberer_region(graine, taille_region(), dans_sol, age, NULL);
+}
+
+/*
+ * Partition bon marché du graphe par propagation d'étiquettes (quelques passes),
+ * calculée une fois par graphe (generation_graphe) et par thread.
+ */
+thread_local vector<int> etiquettes_partition;
+thread_local uint64_t generation_partition = 0;  // generation_graphe du graphe partitionné
+
+const vector<int>& partition_graphe() {
+    if (generation_partition == generation_graphe) return etiquettes_partition;
+    generation_partition = generation_graphe;
+
+    vector<int>& etiquette = etiquettes_partition;
+    etiquette.resize(n_sommets);
+    for (int i = 0; i < n_sommets; ++i) etiquette[i] = i;
+
+    vector<int> ordre(n_sommets);
+    for (int i = 0; i < n_sommets; ++i) ordre[i] = i;
+    map<int, int> frequence;
+
+    for (int passe = 0; passe < 5; ++passe) {
+        for (int i = 0; i < n_sommets; ++i) swap(ordre[i], ordre[i + flux_intensification.entier(n_sommets - i)]);
+
+        bool change = false;
+        for (int v : ordre) {
+            if (voisins[v].empty()) continue;
+            frequence.clear();
+            for (int u : voisins[v]) frequence[etiquette[u]]++;
+
+            int meilleure = etiquette[v], max_freq = 0;
+            for (map<int, int>::iterator it = frequence.begin(); it != frequence.end(); ++it) {
+                if (it->second > max_freq) {
+                    max_freq = it->second;
+                    meilleure = it->first;
+                }
+            }
+            if (meilleure != etiquette[v]) {
+                etiquette[v] = meilleure;
+                change = true;
+            }
+        }
+        if (!change) break;
+    }
+    return etiquette;
 }
 
+/* Voisinage partition : un cluster tiré au hasard, complété par ses voisins si trop petit */
+void voisinage_partition(const Solution& solution_courante, vector<int>& age) {
+    vector<char>& dans_sol = arene.dans_sol;
+    indicatrice_solution(solution_courante, dans_sol);
+    const vector<int>& etiquettes = partition_graphe();
+    liberer_region(flux_intensification.entier(n_sommets), taille_region(), dans_sol, age, &etiquettes);
+}
 
+enum { VOISINAGE_ALEATOIRE = 0, VOISINAGE_BFS, VOISINAGE_PARTITION, VOISINAGE_REDONDANCE, N_VOISINAGES };
 
+GenerateurVoisinage generateurs_voisinage[N_VOISINAGES] = {
+    voisinage_aleatoire, voisinage_bfs, voisinage_partition, voisinage_redondance
+};
+const char* noms_voisinage[N_VOISINAGES] = { "aleatoire", "bfs", "partition", "redondance" };
 
 
 
-/* Phase de diversification */
 
 
 
-/* Phase de diversification avec reconstruction intelligente */
-Solution phase_diversification_avec_roulette(Solution solution_initiale, double temps_limit,
-                                             default_random_engine& generator,
-                                             uniform_real_distribution<double>& distribution) {
+/* Phase d'intensification */
+
+/*
+ * État du local branching « à la Fischetti-Lodi » propre à un thread :
+ * rayon courant et boules déjà explorées (contraintes inversées).
+ */
+struct EtatContrainteLB {
+    int k_courant;
+    vector<ContrainteDistance> inversees;
+
+    EtatContrainteLB() : k_courant(-1) {}
+};
+thread_local EtatContrainteLB etat_contrainte_lb;
+
+/*
+ * Mise à jour de l'état après la résolution de la boule Delta(x, x_bar) <= k_courant :
+ *  - boule explorée entièrement (optimum prouvé ou aucune solution sous le cutoff) :
+ *    la contrainte est inversée (Delta >= k_courant + 1) pour les appels suivants ;
+ *    sans amélioration, le prochain appel sur le même centre explore l'anneau
+ *    suivant (k_courant + k/2), comme la diversification de Fischetti et Lodi ;
+ *  - limite de temps sans amélioration : le rayon est divisé par deux ;
+ *  - amélioration : le rayon revient à k.
+ * L'inversion n'est valide que si la boule est le seul voisinage (LB_SEULE) : avec
+ * la fixation aléatoire, seule une partie de la boule a été explorée.
+ */
+void mettre_a_jour_contrainte_lb(const Solution& centre, bool amelioration, LogFile& logFile) {
+    EtatContrainteLB& etat = etat_contrainte_lb;
+    bool prouve = dernier_statut_cplex.find("optimal") != string::npos ||
+                  dernier_statut_cplex.find("infeasible") != string::npos;
+
+    if (prouve && mode_contrainte_lb == LB_SEULE) {
+        // Une seule contrainte inversée par centre : on élargit celle qui existe
+        vector<ContrainteDistance>::iterator it = etat.inversees.begin();
+        while (it != etat.inversees.end() && it->centre != centre.vertices) ++it;
+        if (it == etat.inversees.end()) {
+            ContrainteDistance inverse;
+            inverse.centre = centre.vertices;
+            inverse.inversee = true;
+            etat.inversees.push_back(inverse);
+            it = etat.inversees.end() - 1;
+        }
+        it->rayon = etat.k_courant + 1;
+        if ((int)etat.inversees.size() > max_contraintes_inversees) {
+            etat.inversees.erase(etat.inversees.begin());
+        }
+        JOURNAL(logFile) << "Local branching: boule k=" << etat.k_courant << " exploree, contrainte inversee ("
+                         << etat.inversees.size() << " actives)";
+    }
+
+    if (amelioration) {
+        etat.k_courant = k_effectif;
+    } else if (prouve) {
+        if (mode_contrainte_lb == LB_SEULE) {
+            etat.k_courant = min(n_sommets, etat.k_courant + (k_effectif + 1) / 2);
+        }
+    } else if (etat.k_courant > 1) {
+        etat.k_courant = max(1, etat.k_courant / 2);
+        JOURNAL_CONSOLE << "Local branching: pas d'amelioration dans le temps imparti, k=" << etat.k_courant;
+    }
+}
+
+/*
+ * Découpe jusqu'à n_voulues régions connexes de taille sommets au plus, deux à deux
+ * à distance >= 3 : aucune contrainte PIDS (un sommet et ses voisins) ne contient de
+ * variables libres de deux régions, les sous-problèmes sont donc indépendants.
+ * Graines choisies comme dans voisinage_bfs (faible marge), hors des zones bloquées
+ * (emprunte arene.dans_sol, arene.couverture, arene.visite, arene.marque et arene.file).
+ */
+vector<vector<int>> decouper_regions(const Solution& solution, int n_voulues, int taille) {
+    vector<char>& dans_sol = arene.dans_sol;
+    vector<int>& couverture = arene.couverture;
+    indicatrice_solution(solution, dans_sol);
+    calculer_couverture(dans_sol, couverture);
+    vector<char>& bloque = arene.visite;  // Dans une région ou à distance <= 2 d'une région
+    bloque.assign(n_sommets, 0);
+    vector<char>& dans_region = arene.marque;  // Remis à zéro après chaque région par ses sommets
+    dans_region.assign(n_sommets, 0);
+    vector<int>& file = arene.file;
+    vector<int> anneau;
+    vector<vector<int>> regions;
+
+    for (int essai = 0; essai < 4 * n_voulues && (int)regions.size() < n_voulues; ++essai) {
+        int graine = -1;
+        int meilleure_marge = numeric_limits<int>::max();
+        for (int t = 0; t < 16; ++t) {
+            int v = flux_intensification.entier(n_sommets);
+            if (bloque[v]) continue;
+            int marge = dans_sol[v] ? n_sommets : couverture[v] - seuils[v];
+            if (graine < 0 || marge < meilleure_marge) {
+                meilleure_marge = marge;
+                graine = v;
+            }
+        }
+        if (graine < 0) continue;
+
+        // Boule BFS limitée aux sommets non bloqués ; file plate parcourue par tete
+        vector<int> region;
+        file.clear();
+        file.push_back(graine);
+        bloque[graine] = 1;
+        size_t tete = 0;
+        while (tete < file.size() && (int)region.size() < taille) {
+            int v = file[tete++];
+            region.push_back(v);
+            for (int u : voisins[v]) {
+                if (!bloque[u]) {
+                    bloque[u] = 1;
+                    file.push_back(u);
+                }
+            }
+        }
+
+        // Zone tampon : premier anneau, puis voisins du premier anneau
+        for (int v : region) dans_region[v] = 1;
+        anneau.clear();
+        for (int v : region) {
+            for (int u : voisins[v]) {
+                if (!dans_region[u]) {
+                    dans_region[u] = 1;
+                    anneau.push_back(u);
+                }
+            }
+        }
+        for (size_t i = tete; i < file.size(); ++i) bloque[file[i]] = 1;  // Découverts mais non pris : déjà dans l'anneau
+        for (int u : anneau) {
+            bloque[u] = 1;
+            for (int w : voisins[u]) bloque[w] = 1;
+        }
+        for (int v : region) dans_region[v] = 0;
+        for (int u : anneau) dans_region[u] = 0;
+
+        regions.push_back(move(region));
+    }
+    return regions;
+}
+
+/*
+ * Intensification sur plusieurs régions indépendantes : les sous-problèmes sont
+ * écrits par le thread courant (qui porte le graphe), résolus en parallèle par
+ * n_threads workers (un processus CPLEX et des fichiers par région), puis toutes
+ * les régions améliorantes sont fusionnées en une seule étape.
+ */
+Solution phase_intensification_regions(const Solution& solution_courante, double temps_limit,
+                                       LogFile& logFile) {
+    vector<vector<int>> regions = decouper_regions(solution_courante, n_regions, taille_region());
+    int n_reg = regions.size();
+    vector<char> dans_sol;
+    indicatrice_solution(solution_courante, dans_sol);
+
+    // 1. Écriture des sous-problèmes
+    vector<FichiersCplex> fichiers(n_reg);
+    vector<PidsModel> modeles(solveur_natif ? n_reg : 0);
+    vector<char> ecrit(n_reg, 0);
+    vector<int> age(n_sommets);
+    for (int r = 0; r < n_reg; ++r) {
+        for (int i = 0; i < n_sommets; ++i) age[i] = dans_sol[i] ? 1 : -1;
+        for (int v : regions[r]) age[v] = 0;
+
+        if (solveur_natif) {
+            modeles[r] = modele_sous_probleme(age, NULL);
+            ecrit[r] = 1;
+            continue;
+        }
+        fichiers[r] = fichiers_cplex(prefixe_fichiers_cplex + "reg" + to_string(r) + "_");
+        ecrit[r] = ecrire_sous_probleme(fichiers[r], solution_courante, age, temps_limit,
+                                        cutoff_amelioration(solution_courante),
+                                        emphase_effective(emphase_intensification), cplex_abort, NULL);
+    }
+
+    // 2. Résolutions concurrentes
+    vector<vector<int>> valeurs(n_reg);
+    vector<string> statuts(n_reg);
+    vector<char> resolu(n_reg, 0);
+    double cutoff = cutoff_amelioration(solution_courante);
+    const atomic<bool>* annulation = jeton_annulation;
+    executer_en_parallele(n_reg, n_threads, [&](int r) {
+        if (!ecrit[r]) return;
+        if (solveur_natif) {
+            resolu[r] = resoudre_modele_natif(modeles[r], NULL, temps_limit, cutoff, cplex_abort, threads_bnb,
+                                              annulation, valeurs[r], statuts[r]);
+        } else {
+            resolu[r] = resoudre_sous_probleme(fichiers[r], valeurs[r], statuts[r]);
+        }
+    });
+
+    // 3. Fusion des régions améliorantes
+    Solution fusion = solution_courante;
+    vector<char> a_un(n_sommets, 0);
+    int n_ameliorees = 0;
+    for (int r = 0; r < n_reg; ++r) {
+        if (!resolu[r]) continue;
+
+        for (int v : valeurs[r]) {
+            if (v >= 0 && v < n_sommets) a_un[v] = 1;
+        }
+        int delta = 0;
+        for (int v : regions[r]) delta += a_un[v] - dans_sol[v];
+
+        if (delta < 0) {
+            for (int v : regions[r]) {
+                if (a_un[v]) fusion.vertices.insert(v);
+                else fusion.vertices.erase(v);
+            }
+            n_ameliorees++;
+        }
+        for (int v : valeurs[r]) {
+            if (v >= 0 && v < n_sommets) a_un[v] = 0;
+        }
+    }
+    fusion.score = fusion.vertices.size();
+
+    JOURNAL(logFile) << "Intensification parallele: " << n_reg << " regions, " << n_ameliorees
+                     << " ameliorantes (score " << solution_courante.score << " -> " << fusion.score << ")";
+
+    if (!solution_realisable(fusion)) {
+        JOURNAL_CONSOLE << "Fusion des regions invalide: solution courante conservee";
+        return solution_courante;
+    }
+    return fusion;
+}
+
+/* Phase d'intensification utilisant run_cplex avec Alpha controlé */
+/*
+ * Un appel de CPLEX sur un voisinage de solution_courante. Retourne true et place
+ * la solution dans amelioree si elle est strictement meilleure ; sinon amelioree
+ * n'est pas modifiée (aucune copie de la solution courante). Emprunte arene.age.
+ */
+bool phase_intensification_avec_run_cplex(const Solution& solution_courante, double temps_limit,
+                                          LogFile& logFile, Solution& amelioree) {
+
+    if (n_regions > 1 && mode_contrainte_lb == LB_AUCUNE) {
+        Solution fusion = phase_intensification_regions(solution_courante, temps_limit, logFile);
+        if (fusion.score >= solution_courante.score) return false;
+        amelioree = move(fusion);
+        return true;
+    }
+
+    // 1. Définir l'espace de recherche (voisinage)
+    vector<int>& age = arene.age;
+    age.assign(n_sommets, -1);  // -1 = sommet fixé à 0, 0 = sommet libre (binaire)
+
+    if (mode_contrainte_lb == LB_SEULE) {
+        // La boule de Hamming remplace la fixation aléatoire : tout est libre
+        fill(age.begin(), age.end(), 0);
+    } else {
+        generateurs_voisinage[generateur_voisinage](solution_courante, age);
+    }
 
-    clock_t debut = clock();
-    Solution meilleure_solution = solution_initiale;
+    // Contrainte de local branching autour de la solution courante
+    vector<ContrainteDistance> distances;
+    if (mode_contrainte_lb != LB_AUCUNE) {
+        if (etat_contrainte_lb.k_courant < 1) etat_contrainte_lb.k_courant = k_effectif;
+        distances = etat_contrainte_lb.inversees;
+
+        ContrainteDistance boule;
+        boule.centre = solution_courante.vertices;
+        boule.rayon = etat_contrainte_lb.k_courant;
+        boule.inversee = false;
+        distances.push_back(boule);
+    }
+
+    // 2. Appeler CPLEX sur ce sous-problème (solution courante comme warm-start)
+    Solution solution_cplex;
+    double temps_restant = temps_limit;
+
+    run_cplex(solution_cplex, solution_courante, age, temps_restant,
+              cutoff_amelioration(solution_courante), emphase_effective(emphase_intensification),
+              cplex_abort, distances.empty() ? NULL : &distances);
+
+    // 3. Vérifier et retourner
+    bool amelioration = solution_cplex.score < solution_courante.score &&
+                        solution_realisable(solution_cplex);
+    if (mode_contrainte_lb != LB_AUCUNE) {
+        mettre_a_jour_contrainte_lb(solution_courante, amelioration, logFile);
+    }
+
+    if (amelioration) amelioree = move(solution_cplex);
+    return amelioration;
+}
+
+
+
+
+
+
+/* Phase de diversification */
+
+
+
+/*
+ * Phase de diversification avec reconstruction intelligente.
+ * Retourne true si une reconstruction bat solution_initiale ; amelioree reçoit
+ * alors la meilleure. Les ensembles de travail (noyau, sommets considérés, C)
+ * sont des indicatrices de l'arène : une fois les tampons dimensionnés, une
+ * reconstruction n'alloue plus rien, seule une amélioration construit un Solution.
+ * Emprunte arene.dans_sol, marque, domine, besoins, consideres, position, fenwick
+ * (et sommets, bits via les fonctions appelées).
+ */
+bool phase_diversification_avec_roulette(const Solution& solution_initiale, double temps_limit,
+                                         FluxAleatoire& generator,
+                                         uniform_real_distribution<double>& distribution,
+                                         Solution& amelioree) {
+
+    // Temps réel : clock() cumule le temps CPU de tous les threads du processus
+    chrono::steady_clock::time_point debut = chrono::steady_clock::now();
+    const Solution* meilleure_solution = &solution_initiale;
+    bool premiere = true;
+
+    vector<char>& dans_sol = arene.dans_sol;     // Solution en reconstruction (noyau puis ajouts)
+    vector<char>& supprime = arene.marque;
+    vector<char>& domine = arene.domine;         // C = sommets non dominés = !domine
+    vector<int>& besoins = arene.besoins;
+    vector<int>& consideres = arene.consideres;  // Croissants, comme l'ancien set<int>
+    vector<int>& position = arene.position;      // Rang de chaque sommet dans consideres
+    vector<long long>& fenwick = arene.fenwick;  // Degrés des candidats, par rang dans consideres
 
     while (true) {
-        double temps_ecoule = double(clock() - debut) / CLOCKS_PER_SEC;
-        if (temps_ecoule >= temps_limit) {
+        double temps_ecoule = secondes_depuis(debut);
+        if (temps_ecoule >= temps_limit || annulation_demandee()) {
             break;
         }
+        long long allocations_debut = compteur_allocations();
 
         // 1. Destruction : supprimer une partie de la solution
-        set<int> sommets_supprimes = supprimer_pourcentage(meilleure_solution, param_beta, generator, distribution);
+        supprimer_pourcentage(*meilleure_solution, beta_effectif, generator, distribution, supprime);
 
         // 2. Garder le noyau (sommets non supprimés)
-        set<int> noyau;
-        for (int v : meilleure_solution.vertices) {
-            if (sommets_supprimes.find(v) == sommets_supprimes.end()) {
-                noyau.insert(v);
+        dans_sol.assign(n_sommets, 0);
+        int score_reconstruit = 0;
+        for (int v : meilleure_solution->vertices) {
+            if (!supprime[v]) {
+                dans_sol[v] = 1;
+                score_reconstruit++;
             }
         }
 
-        // 3. Reconstruction avec l'heuristique de roulette sur le sous-problème
-        // Créer un sous-graphe des sommets à considérer
-        set<int> sommets_a_considerer;
-
-        // Inclure les sommets supprimés
-        sommets_a_considerer.insert(sommets_supprimes.begin(), sommets_supprimes.end());
-
-        // Inclure les sommets non dominés par le noyau
+        // 3. Reconstruction avec l'heuristique de roulette sur le sous-problème :
+        // sommets supprimés et sommets non dominés par le noyau
+        marquer_sommets_domines(dans_sol, domine);
+        consideres.clear();
+        int taille_C = 0;
         for (int i = 0; i < n_sommets; ++i) {
-            Solution temp_solution;
-            temp_solution.vertices = noyau;
-            if (!est_domine(i, temp_solution)) {
-                sommets_a_considerer.insert(i);
-            }
+            if (!domine[i]) taille_C++;
+            if (supprime[i] || !domine[i]) consideres.push_back(i);
         }
 
         // 4. Appliquer l'heuristique de roulette sur le sous-graphe
-        if (!sommets_a_considerer.empty()) {
-            // Créer une copie modifiée de l'heuristique pour travailler sur le sous-ensemble
-            Solution solution_reconstruite;
-            solution_reconstruite.vertices = noyau;  // Commencer avec le noyau
-            solution_reconstruite.score = noyau.size();
-
-            // Identifier les sommets non encore dominés
-            set<int> C;  // Sommets non dominés
-            for (int i = 0; i < n_sommets; ++i) {
-                if (!est_domine(i, solution_reconstruite)) {
-                    C.insert(i);
-                }
-            }
-
+        if (!consideres.empty()) {
             // Calculer les besoins initiaux
-            vector<int> besoins(n_sommets, 0);
-            for (int i : C) {
-                besoins[i] = ceil(voisins[i].size() * 0.5);
+            besoins.assign(n_sommets, 0);
+            for (int i : consideres) {
+                if (!domine[i]) besoins[i] = seuils[i];
             }
 
-            // Heuristique de roulette adaptée
-            while (!C.empty()) {
-                // Créer une distribution sur les sommets à considérer
-                vector<int> candidats;
-                for (int v : sommets_a_considerer) {
-                    if (C.find(v) != C.end() ||
-                        (solution_reconstruite.vertices.find(v) == solution_reconstruite.vertices.end() &&
-                         sommets_a_considerer.find(v) != sommets_a_considerer.end())) {
-                        candidats.push_back(v);
+            // Candidats (sommets de C ou pas encore dans la solution) : au départ tout consideres,
+            // qui est hors de la solution ; un sommet ajouté cesse d'être candidat. Arbre de
+            // Fenwick des degrés : tirage de la roulette en O(log n) au lieu d'un parcours
+            int m = consideres.size();
+            int n_candidats = m;
+            fenwick.assign(m + 1, 0);
+            position.resize(n_sommets);
+            for (int i = 0; i < m; ++i) {
+                position[consideres[i]] = i;
+                fenwick[i + 1] += voisins.degree(consideres[i]);
+                int parent = (i + 1) + ((i + 1) & -(i + 1));
+                if (parent <= m) fenwick[parent] += fenwick[i + 1];
+            }
+            // Premier rang dont le cumul des degrés atteint cible (comme r <= cumul dans l'ancien parcours)
+            auto rang_cumul = [&](double cible) {
+                int pos = 0;
+                long long cumul = 0;
+                for (int pas = 1 << 30; pas > 0; pas >>= 1) {
+                    if (pos + pas <= m && cumul + fenwick[pos + pas] < cible) {
+                        pos += pas;
+                        cumul += fenwick[pos];
+                    }
+                }
+                return min(pos, m - 1);
+            };
+
+            // Ajoute v à la solution et met à jour C, les besoins et les candidats
+            auto ajouter = [&](int v) {
+                if (!dans_sol[v] || !domine[v]) {
+                    n_candidats--;
+                    int d = voisins.degree(v);
+                    for (int i = position[v] + 1; i <= m; i += i & -i) fenwick[i] -= d;
+                }
+                dans_sol[v] = 1;
+                score_reconstruit++;
+                besoins[v] = 0;
+                for (int voisin : voisins[v]) {
+                    if (besoins[voisin] > 0) {
+                        besoins[voisin]--;
+                        if (besoins[voisin] == 0 && !domine[voisin]) {
+                            domine[voisin] = 1;
+                            taille_C--;
+                        }
                     }
                 }
+                if (!domine[v]) {
+                    domine[v] = 1;
+                    taille_C--;
+                }
+            };
 
-                if (candidats.empty()) {
-                    // Si plus de candidats, ajouter un sommet aléatoire pour dominer les restants
-                    if (!C.empty()) {
-                        auto it = C.begin();
-                        advance(it, rand() % C.size());
-                        int sommet_ajoute = *it;
-                        solution_reconstruite.vertices.insert(sommet_ajoute);
-                        solution_reconstruite.score++;
-
-                        // Mettre à jour C et besoins
-                        besoins[sommet_ajoute] = 0;
-                        for (int voisin : voisins[sommet_ajoute]) {
-                            if (besoins[voisin] > 0) {
-                                besoins[voisin]--;
-                                if (besoins[voisin] == 0) {
-                                    C.erase(voisin);
-                                }
-                            }
+            // Heuristique de roulette adaptée
+            while (taille_C > 0) {
+                if (n_candidats == 0) {
+                    // Si plus de candidats, ajouter le r-ième sommet de C pour dominer les restants
+                    int r = generator.entier(taille_C);
+                    for (int v : consideres) {
+                        if (!domine[v] && r-- == 0) {
+                            ajouter(v);
+                            break;
                         }
-                        C.erase(sommet_ajoute);
                     }
                     continue;
                 }
 
                 // Roulette : probabilité proportionnelle au degré
-                int total_deg = 0;
-                vector<int> deg_candidats(candidats.size());
-                for (size_t i = 0; i < candidats.size(); ++i) {
-                    deg_candidats[i] = voisins[candidats[i]].size();
-                    total_deg += deg_candidats[i];
-                }
+                long long total_deg = 0;
+                for (int i = m; i > 0; i -= i & -i) total_deg += fenwick[i];
 
                 if (total_deg == 0) {
                     // Tous les sommets isolés
-                    for (int v : candidats) {
-                        solution_reconstruite.vertices.insert(v);
-                        solution_reconstruite.score++;
+                    for (int v : consideres) {
+                        if (!domine[v] || !dans_sol[v]) {
+                            dans_sol[v] = 1;
+                            score_reconstruit++;
+                        }
                     }
                     break;
                 }
 
                 // Sélection par roulette
                 double r = distribution(generator);
-                double cumul = 0.0;
-                int sommet_selectionne = candidats[0];
-
-                for (size_t i = 0; i < candidats.size(); ++i) {
-                    double proba = (double)deg_candidats[i] / total_deg;
-                    cumul += proba;
-                    if (r <= cumul) {
-                        sommet_selectionne = candidats[i];
-                        break;
-                    }
-                }
-
-                // Ajouter le sommet sélectionné
-                solution_reconstruite.vertices.insert(sommet_selectionne);
-                solution_reconstruite.score++;
-
-                // Mettre à jour C et besoins
-                besoins[sommet_selectionne] = 0;
-                for (int voisin : voisins[sommet_selectionne]) {
-                    if (besoins[voisin] > 0) {
-                        besoins[voisin]--;
-                        if (besoins[voisin] == 0) {
-                            C.erase(voisin);
-                        }
-                    }
-                }
-                C.erase(sommet_selectionne);
+                ajouter(consideres[rang_cumul(max(r * total_deg, 0.5))]);  // Cible > 0 : jamais un rang de poids nul
             }
 
             // 5. Vérifier et accepter la solution
-            bool solution_valide = true;
-            for (int i = 0; i < n_sommets; ++i) {
-                if (!est_domine(i, solution_reconstruite)) {
-                    solution_valide = false;
-                    break;
+            if (score_reconstruit < meilleure_solution->score && indicatrice_realisable(dans_sol)) {
+                amelioree.vertices.clear();
+                for (int v = 0; v < n_sommets; ++v) {
+                    if (dans_sol[v]) amelioree.vertices.insert(amelioree.vertices.end(), v);
                 }
+                amelioree.score = score_reconstruit;
+                meilleure_solution = &amelioree;
             }
+        }
 
-            if (solution_valide && solution_reconstruite.score < meilleure_solution.score) {
-                meilleure_solution = solution_reconstruite;
-            }
+        if (allocations_debut >= 0 && !premiere) {
+            reconstructions_mesurees++;
+            allocations_reconstructions += compteur_allocations() - allocations_debut;
         }
+        premiere = false;
     }
 
-    return meilleure_solution;
-}
+    return meilleure_solution == &amelioree;
+}
+
+
+
+
+// ====================================================
+// CONTRÔLE ADAPTATIF DES PARAMÈTRES
+// ====================================================
+
+/*
+ * Bandit UCB1 sur des couples (taille du voisinage, répartition du temps) :
+ *  - facteur_taille multiplie alpha, beta et k ;
+ *  - facteur_budget multiplie -ti et divise -td.
+ * Chaque itération du local branching tire un bras ; la récompense est
+ * l'amélioration du score par seconde de l'itération. Les statistiques sont
+ * escomptées (facteur 0.9 par tirage) : les premières itérations, qui améliorent
+ * facilement, ne figent pas le choix pour le reste de la résolution.
+ */
+struct BrasAdaptatif {
+    double facteur_taille;
+    double facteur_budget;
+    int n_tirages;
+    double poids;               // Nombre de tirages escompté
+    double somme_recompenses;   // Somme escomptée des récompenses
+};
+
+const double escompte_adaptatif = 0.9;
+
+struct ControleurAdaptatif {
+    vector<BrasAdaptatif> bras;
+    double poids_total;
+    double recompense_max;  // Normalisation des récompenses dans [0, 1]
+};
+
+void initialiser_controleur(ControleurAdaptatif& c) {
+    const double tailles[] = { 0.5, 1.0, 2.0 };
+    const double budgets[] = { 0.5, 1.0, 2.0 };
+    c.bras.clear();
+    for (double t : tailles) {
+        for (double b : budgets) {
+            BrasAdaptatif bras;
+            bras.facteur_taille = t;
+            bras.facteur_budget = b;
+            bras.n_tirages = 0;
+            bras.poids = 0.0;
+            bras.somme_recompenses = 0.0;
+            c.bras.push_back(bras);
+        }
+    }
+    c.poids_total = 0.0;
+    c.recompense_max = 0.0;
+}
+
+/* Bras non encore tiré en priorité, sinon le meilleur indice UCB1 */
+int choisir_bras(const ControleurAdaptatif& c) {
+    int meilleur = 0;
+    double meilleur_indice = -1.0;
+    for (size_t i = 0; i < c.bras.size(); ++i) {
+        const BrasAdaptatif& b = c.bras[i];
+        if (b.n_tirages == 0) return i;
+
+        double moyenne = b.somme_recompenses / b.poids;
+        if (c.recompense_max > 0) moyenne /= c.recompense_max;
+        double indice = moyenne + sqrt(2.0 * log(max(c.poids_total, 1.0)) / b.poids);
+        if (indice > meilleur_indice) {
+            meilleur_indice = indice;
+            meilleur = i;
+        }
+    }
+    return meilleur;
+}
+
+/* Fixe les paramètres effectifs du thread et les budgets de l'itération selon le bras */
+void appliquer_bras(const BrasAdaptatif& b, double& temps_intensif, double& temps_diversif,
+                    LogFile& logFile) {
+    alpha_effectif = min(1.0, alpha * b.facteur_taille);
+    beta_effectif = min(1.0, param_beta * b.facteur_taille);
+    int k_precedent = k_effectif;
+    k_effectif = max(1, (int)(k * b.facteur_taille + 0.5));
+    // Le rayon -lbc (anneaux, réductions) repart du nouveau k
+    if (k_effectif != k_precedent && etat_contrainte_lb.k_courant > 0) {
+        etat_contrainte_lb.k_courant = k_effectif;
+    }
+    temps_intensif = temps_intensification_limit * b.facteur_budget;
+    temps_diversif = temps_diversification_limit / b.facteur_budget;
+
+    ostringstream oss;
+    oss << "Controle adaptatif: alpha=" << alpha_effectif << ", beta=" << beta_effectif
+        << ", k=" << k_effectif << ", ti=" << temps_intensif << ", td=" << temps_diversif;
+    JOURNAL(logFile) << oss.str();
+}
+
+void recompenser_bras(ControleurAdaptatif& c, int i, int gain, double duree, LogFile& logFile) {
+    double recompense = gain / max(duree, 1e-3);
+    c.poids_total = 0.0;
+    for (BrasAdaptatif& b : c.bras) {
+        b.poids *= escompte_adaptatif;
+        b.somme_recompenses *= escompte_adaptatif;
+        c.poids_total += b.poids;
+    }
+    c.bras[i].n_tirages++;
+    c.bras[i].poids += 1.0;
+    c.bras[i].somme_recompenses += recompense;
+    c.poids_total += 1.0;
+    c.recompense_max = max(c.recompense_max * escompte_adaptatif, recompense);
+
+    ostringstream oss;
+    oss << "Controle adaptatif: gain " << gain << " en " << duree << " s (recompense "
+        << recompense << "/s, bras tire " << c.bras[i].n_tirages << " fois)";
+    JOURNAL(logFile) << oss.str();
+}
+
+
+
+
+// ====================================================
+// PATH RELINKING
+// ====================================================
+
+/*
+ * Les solutions améliorées par le local branching partagent une grande partie de
+ * leurs sommets. Un chemin relie une solution de départ à une solution guide :
+ * chaque pas retire un sommet du départ absent du guide, puis rétablit la
+ * domination avec des sommets du guide. Toutes les solutions du chemin sont
+ * réalisables, et la meilleure d'entre elles peut battre les deux extrémités.
+ * Un pas ne coûte que des mises à jour de couverture autour du sommet retiré,
+ * bien moins qu'un sous-problème CPLEX sur la différence des deux solutions.
+ */
+
+/* Ajoute une solution à l'élite (sans doublon), en gardant les taille meilleures ; true si elle y entre */
+bool inserer_elite(vector<Solution>& elite, const Solution& sol, int taille) {
+    for (const Solution& e : elite) {
+        if (e.vertices == sol.vertices) return false;
+    }
+    if ((int)elite.size() >= taille && sol.score >= elite.back().score) return false;
+    elite.push_back(sol);
+    sort(elite.begin(), elite.end(),
+         [](const Solution& a, const Solution& b) { return a.score < b.score; });
+    if ((int)elite.size() > taille) elite.resize(taille);
+    return true;
+}
+
+/*
+ * Chemin de depart vers guide sur le graphe adj et les seuils h, passés
+ * explicitement : les workers n'ont pas le graphe thread_local de l'appelant.
+ * Le sommet retiré à chaque pas est celui dont le retrait laisse le moins de
+ * sommets non dominés (file de priorité paresseuse : coût recalculé à la sortie,
+ * reposé dans la file quand un ajout l'a fait baisser). Chaque sommet non dominé
+ * est réparé par les sommets du guide de son voisinage fermé qui en dominent le
+ * plus ; le guide étant réalisable, la réparation aboutit toujours. Retourne la
+ * meilleure solution intermédiaire (depart s'il n'y a aucun pas).
+ */
+Solution relier_solutions(const CompressedAdjacency& adj, const vector<int>& h, const Solution& depart,
+                          const Solution& guide, const chrono::steady_clock::time_point& fin) {
+    int n = adj.size();
+    vector<char> dans_sol(n, 0), dans_guide(n, 0), viole(n, 0);
+    vector<int> couverture(n, 0);
+    for (int v : depart.vertices) dans_sol[v] = 1;
+    for (int v : guide.vertices) dans_guide[v] = 1;
+    for (int v : depart.vertices) {
+        for (int u : adj[v]) couverture[u]++;
+    }
+
+    // Sommets que le retrait de u laisserait non dominés (u et ses voisins tout juste dominés)
+    auto cout_retrait = [&](int u) {
+        int c = couverture[u] < h[u] ? 1 : 0;
+        for (int w : adj[u]) {
+            if (!dans_sol[w] && couverture[w] == h[w]) c++;
+        }
+        return c;
+    };
+    typedef pair<int, int> Entree;  // (coût, sommet)
+    priority_queue<Entree, vector<Entree>, greater<Entree>> file;
+    for (int u : depart.vertices) {
+        if (!dans_guide[u]) file.push(Entree(cout_retrait(u), u));
+    }
+    auto reposer = [&](int z) {
+        if (dans_sol[z] && !dans_guide[z]) file.push(Entree(cout_retrait(z), z));
+    };
+
+    vector<int> mouvements;  // u : ajout, ~u : retrait
+    vector<int> violes;
+    int score = depart.score;
+    int meilleur_score = numeric_limits<int>::max();
+    size_t meilleur_pas = 0;
+    unsigned extractions = 0;  // Horloge lue toutes les 64 entrées (mouvements avance par bonds)
+
+    while (!file.empty()) {
+        if ((extractions++ & 63) == 0 && (chrono::steady_clock::now() >= fin || annulation_demandee())) break;
+
+        Entree e = file.top();
+        file.pop();
+        int u = e.second;
+        if (!dans_sol[u]) continue;  // Doublon d'un sommet déjà retiré
+        int c = cout_retrait(u);
+        if (c != e.first) {
+            file.push(Entree(c, u));
+            continue;
+        }
+
+        // Retrait
+        dans_sol[u] = 0;
+        score--;
+        mouvements.push_back(~u);
+        for (int w : adj[u]) couverture[w]--;
+
+        // Réparation par des sommets du guide
+        violes.clear();
+        if (couverture[u] < h[u]) violes.push_back(u);
+        for (int w : adj[u]) {
+            if (!dans_sol[w] && couverture[w] < h[w]) violes.push_back(w);
+        }
+        for (int w : violes) viole[w] = 1;
+        auto reste_viole = [&](int y) { return viole[y] && !dans_sol[y] && couverture[y] < h[y]; };
+
+        for (int w : violes) {
+            while (reste_viole(w)) {
+                int meilleur = -1, meilleur_gain = 0;
+                auto evaluer = [&](int x) {
+                    if (dans_sol[x] || !dans_guide[x]) return;
+                    int gain = reste_viole(x) ? 1 : 0;
+                    for (int y : adj[x]) gain += reste_viole(y) ? 1 : 0;
+                    if (gain > meilleur_gain) { meilleur_gain = gain; meilleur = x; }
+                };
+                evaluer(w);
+                for (int x : adj[w]) evaluer(x);
+
+                dans_sol[meilleur] = 1;
+                score++;
+                mouvements.push_back(meilleur);
+                for (int y : adj[meilleur]) couverture[y]++;
+
+                // Coûts de retrait en baisse : voisins de l'ajout, et voisins des sommets qu'il rend non critiques
+                for (int y : adj[meilleur]) {
+                    reposer(y);
+                    if (!dans_sol[y] && couverture[y] == h[y] + 1) {
+                        for (int z : adj[y]) reposer(z);
+                    }
+                }
+            }
+        }
+        for (int w : violes) viole[w] = 0;
+
+        if (score < meilleur_score) {
+            meilleur_score = score;
+            meilleur_pas = mouvements.size();
+        }
+    }
+
+    if (meilleur_pas == 0) return depart;
+    Solution meilleure = depart;
+    for (size_t i = 0; i < meilleur_pas; ++i) {
+        if (mouvements[i] >= 0) meilleure.vertices.insert(mouvements[i]);
+        else meilleure.vertices.erase(~mouvements[i]);
+    }
+    meilleure.score = meilleur_score;
+    return meilleure;
+}
+
+/*
+ * Path relinking entre centre et chaque solution de l'élite, dans les deux sens,
+ * chemins répartis sur n_threads workers. Les meilleures solutions intermédiaires,
+ * débarrassées de leurs sommets redondants, entrent dans l'élite. Retourne true et
+ * place dans amelioree la meilleure si elle bat centre.
+ */
+bool phase_path_relinking(const Solution& centre, vector<Solution>& elite, double temps_limit,
+                          LogFile& logFile, Solution& amelioree) {
+    chrono::steady_clock::time_point debut = chrono::steady_clock::now();
+    chrono::steady_clock::time_point fin = debut + chrono::duration_cast<chrono::steady_clock::duration>(
+                                                       chrono::duration<double>(temps_limit));
+
+    vector<const Solution*> autres;
+    for (const Solution& e : elite) {
+        if (e.vertices != centre.vertices) autres.push_back(&e);
+    }
+    int n_chemins = 2 * autres.size();
+    if (n_chemins == 0) return false;
+
+    vector<Solution> resultats(n_chemins);
+    const CompressedAdjacency& adj = voisins;
+    const vector<int>& h = seuils;
+    executer_en_parallele(n_chemins, n_threads, [&](int c) {
+        const Solution& autre = *autres[c / 2];
+        resultats[c] = c % 2 == 0 ? relier_solutions(adj, h, centre, autre, fin)
+                                  : relier_solutions(adj, h, autre, centre, fin);
+    });
+
+    Solution meilleure = centre;
+    vector<char> dans_sol;
+    vector<int> couverture;
+    for (Solution& r : resultats) {
+        indicatrice_solution(r, dans_sol);
+        calculer_couverture(dans_sol, couverture);
+        vector<int> candidats(r.vertices.begin(), r.vertices.end());
+        stable_sort(candidats.begin(), candidats.end(),
+                    [](int a, int b) { return voisins.degree(a) < voisins.degree(b); });
+        retirer_redondants(candidats, dans_sol, couverture, r);
+        r.score = r.vertices.size();
+        if (!solution_realisable(r)) continue;
+
+        inserer_elite(elite, r, taille_elite);
+        if (r.score < meilleure.score) meilleure = r;
+    }
+
+    JOURNAL(logFile) << "Path relinking: " << n_chemins << " chemins, meilleure solution intermediaire "
+                     << meilleure.score << " (centre " << centre.score << ") en "
+                     << secondes_depuis(debut) << " s";
+
+    if (meilleure.score >= centre.score) return false;
+    amelioree = move(meilleure);
+    return true;
+}
+
+
+
+
+// ====================================================
+// POINTS DE REPRISE
+// ====================================================
+
+/*
+ * État complet d'un run de local branching : incumbent, générateurs aléatoires,
+ * temps consommé, statistiques des phases, contrôleur adaptatif, paramètres,
+ * boules -lbc explorées et bornes inférieures (multiplicateurs lagrangiens non nuls).
+ * Fichier texte ; l'incumbent et les centres y sont des bitsets en hexadécimal (4 sommets par caractère).
+ * Les flux aléatoires sont sauvegardés par (clé, compteur) : un run repris suit
+ * exactement la suite de tirages du run interrompu.
+ */
+struct PointReprise {
+    int n;
+    uint64_t empreinte;  // empreinte_graphe() du graphe renuméroté
+    double temps_ecoule;
+    double temps_total, alpha, beta, temps_intensif, temps_diversif;
+    int k;
+    bool adaptatif;
+    int ordre;
+    double rho;
+    FluxAleatoire generateur;
+    FluxAleatoire intensification;
+    int iterations, succes_intensification, succes_reparation, succes_diversification;
+    ControleurAdaptatif controleur;
+    EtatContrainteLB contrainte_lb;
+    BornesInferieures bornes;
+    Solution x_bar;
+};
+
+long long nombre_aretes() {
+    return voisins.edges();
+}
+
+/* Empreinte des listes de voisins et des seuils du graphe du thread, dans l'ordre des sommets */
+uint64_t empreinte_graphe() {
+    uint64_t h = FluxAleatoire::melange(n_sommets);
+    for (int v = 0; v < n_sommets; ++v) {
+        h = FluxAleatoire::melange(h ^ ((uint64_t)voisins.degree(v) << 32 | (uint32_t)seuils[v]));
+        for (int u : voisins[v]) h = FluxAleatoire::melange(h + (uint64_t)u);
+    }
+    return h;
+}
+
+string solution_vers_hex(const Solution& sol, int n) {
+    const char* chiffres = "0123456789abcdef";
+    string hex((n + 3) / 4, '0');
+    for (int v : sol.vertices) {
+        int c = v / 4;
+        hex[c] = chiffres[(strchr(chiffres, hex[c]) - chiffres) | (1 << (v % 4))];
+    }
+    return hex;
+}
+
+Solution hex_vers_solution(const string& hex, int n) {
+    Solution sol;
+    for (int c = 0; c < (int)hex.size(); ++c) {
+        int valeur = isdigit(hex[c]) ? hex[c] - '0' : tolower(hex[c]) - 'a' + 10;
+        for (int b = 0; b < 4; ++b) {
+            if ((valeur >> b) & 1 && 4 * c + b < n) sol.vertices.insert(4 * c + b);
+        }
+    }
+    sol.score = sol.vertices.size();
+    return sol;
+}
+
+/* Écriture atomique : fichier temporaire puis rename(), jamais de point de reprise tronqué */
+bool ecrire_point_reprise(const string& fichier, const PointReprise& p) {
+    string temporaire = fichier + ".tmp";
+    ofstream out(temporaire.c_str());
+    if (!out.is_open()) return false;
+
+    out << setprecision(17);
+    out << "PIDS_CHECKPOINT 5" << endl;
+    out << "graphe " << p.n << " " << p.empreinte << endl;
+    out << "temps_ecoule " << p.temps_ecoule << endl;
+    out << "parametres " << p.temps_total << " " << p.alpha << " " << p.beta << " " << p.k
+        << " " << p.temps_intensif << " " << p.temps_diversif << " " << p.adaptatif << " " << p.ordre << " " << p.rho << endl;
+    out << "flux " << p.generateur.cle() << " " << p.generateur.compteur() << " "
+        << p.intensification.cle() << " " << p.intensification.compteur() << endl;
+    out << "statistiques " << p.iterations << " " << p.succes_intensification << " "
+        << p.succes_reparation << " " << p.succes_diversification << endl;
+    out << "controleur " << p.controleur.bras.size() << " " << p.controleur.poids_total
+        << " " << p.controleur.recompense_max;
+    for (const BrasAdaptatif& b : p.controleur.bras) {
+        out << " " << b.n_tirages << " " << b.poids << " " << b.somme_recompenses;
+    }
+    out << endl;
+    out << "contrainte_lb " << p.contrainte_lb.k_courant << " " << p.contrainte_lb.inversees.size() << endl;
+    for (const ContrainteDistance& c : p.contrainte_lb.inversees) {
+        Solution centre;
+        centre.vertices = c.centre;
+        out << c.rayon << " " << c.inversee << " " << solution_vers_hex(centre, p.n) << endl;
+    }
+    const BornesInferieures& b = p.bornes;
+    size_t non_nuls = 0;
+    for (double l : b.lambda) non_nuls += (l != 0.0);
+    out << "bornes " << b.degre << " " << b.lagrange << " " << b.relaxation_lp << " " << b.meilleure
+        << " " << b.mu << " " << b.lambda.size() << " " << non_nuls;
+    for (size_t i = 0; i < b.lambda.size(); ++i) {
+        if (b.lambda[i] != 0.0) out << " " << i << " " << b.lambda[i];
+    }
+    out << endl;
+    out << "incumbent " << p.x_bar.score << " " << solution_vers_hex(p.x_bar, p.n) << endl;
+    out.close();
+    if (out.fail()) return false;
+
+    return rename(temporaire.c_str(), fichier.c_str()) == 0;
+}
+
+bool lire_point_reprise(const string& fichier, PointReprise& p) {
+    ifstream in(fichier.c_str());
+    if (!in.is_open()) return false;
+
+    string mot, hex;
+    int version;
+    size_t n_bras;
+    in >> mot >> version;
+    if (mot != "PIDS_CHECKPOINT" || version != 5) return false;
+
+    in >> mot >> p.n >> p.empreinte;
+    in >> mot >> p.temps_ecoule;
+    in >> mot >> p.temps_total >> p.alpha >> p.beta >> p.k >> p.temps_intensif >> p.temps_diversif >> p.adaptatif >> p.ordre >> p.rho;
+    uint64_t cle_g, compteur_g, cle_i, compteur_i;
+    in >> mot >> cle_g >> compteur_g >> cle_i >> compteur_i;
+    p.generateur = FluxAleatoire(cle_g, compteur_g);
+    p.intensification = FluxAleatoire(cle_i, compteur_i);
+    in >> mot >> p.iterations >> p.succes_intensification >> p.succes_reparation
+       >> p.succes_diversification;
+    in >> mot >> n_bras >> p.controleur.poids_total >> p.controleur.recompense_max;
+    initialiser_controleur(p.controleur);
+    if (n_bras != p.controleur.bras.size()) return false;
+    for (BrasAdaptatif& b : p.controleur.bras) {
+        in >> b.n_tirages >> b.poids >> b.somme_recompenses;
+    }
+    size_t n_boules;
+    in >> mot >> p.contrainte_lb.k_courant >> n_boules;
+    if (in.fail()) return false;
+    p.contrainte_lb.inversees.resize(n_boules);
+    for (ContrainteDistance& c : p.contrainte_lb.inversees) {
+        in >> c.rayon >> c.inversee >> hex;
+        c.centre = hex_vers_solution(hex, p.n).vertices;
+    }
+    BornesInferieures& b = p.bornes;
+    size_t n_lambda, non_nuls;
+    in >> mot >> b.degre >> b.lagrange >> b.relaxation_lp >> b.meilleure >> b.mu >> n_lambda >> non_nuls;
+    if (in.fail() || n_lambda > (size_t)p.n || non_nuls > n_lambda) return false;
+    b.lambda.assign(n_lambda, 0.0);
+    for (size_t j = 0; j < non_nuls; ++j) {
+        size_t i;
+        in >> i;
+        if (in.fail() || i >= n_lambda) return false;
+        in >> b.lambda[i];
+    }
+    int score;
+    in >> mot >> score >> hex;
+    if (in.fail()) return false;
+
+    p.x_bar = hex_vers_solution(hex, p.n);
+    return p.x_bar.score == score;
+}
+
+
+
+/* Algorithme principal de Local Branching */
+
+
+
+/* Algorithme principal de Local Branching */
+/* Algorithme principal de Local Branching */
+/*
+ * reprise : état lu par lire_point_reprise (paramètres déjà appliqués par l'appelant),
+ * NULL pour un nouveau run.
+ * depart  : solution réalisable remplaçant l'heuristique de roulette (mode -delta).
+ */
+Solution algorithme_local_branching(LogFile& logFile, double temps_limite,
+                                    const PointReprise* reprise = NULL, const Solution* depart = NULL) {
+
+    // Flux propres à ce thread : construction / diversification et voisinages d'intensification
+    FluxAleatoire generator = flux_racine.derive(FLUX_CONSTRUCTION);
+    flux_intensification = flux_racine.derive(FLUX_INTENSIFICATION);
+    uniform_real_distribution<double> distribution(0.0, 1.0);
+
+    chrono::steady_clock::time_point debut_total = chrono::steady_clock::now();
+
+    int iterations = 0, succes_intensification = 0, succes_reparation = 0, succes_diversification = 0;
+    int iterations_debut = 0, succes_relinking = 0;
+    long long allocations_iterations = 0;
+    reconstructions_mesurees = allocations_reconstructions = 0;
+    ControleurAdaptatif controleur;
+    initialiser_controleur(controleur);
+
+    Solution x_bar;
+    if (reprise) {
+        generator = reprise->generateur;
+        flux_intensification = reprise->intensification;
+        debut_total -= chrono::duration_cast<chrono::steady_clock::duration>(
+            chrono::duration<double>(reprise->temps_ecoule));
+        iterations = iterations_debut = reprise->iterations;
+        succes_intensification = reprise->succes_intensification;
+        succes_reparation = reprise->succes_reparation;
+        succes_diversification = reprise->succes_diversification;
+        controleur = reprise->controleur;
+        etat_contrainte_lb = reprise->contrainte_lb;
+        x_bar = reprise->x_bar;
+
+        JOURNAL(logFile) << "Reprise: score = " << x_bar.score << ", temps deja ecoule = "
+                         << reprise->temps_ecoule << " s, iterations = " << iterations;
+    } else if (depart) {
+        x_bar = *depart;
+        JOURNAL(logFile) << "Solution de depart: score = " << x_bar.score;
+    } else {
+        // Appel correct de l'heuristique
+        Solution x0 = heuristique_roulette_exacte(n_sommets, voisins, generator, distribution);
+        x_bar = x0;
+
+        JOURNAL(logFile) << "Solution initiale: score = " << x0.score;
+    }
+    if (rappel_amelioration) rappel_amelioration(x_bar);
+
+    // Élite du path relinking (-relinking) : non sauvegardée, reconstruite après --resume.
+    // Relinking à nouveau seulement si l'élite a reçu une solution hors relinking
+    vector<Solution> elite;
+    bool elite_modifiee = false;
+    if (taille_elite > 0) inserer_elite(elite, x_bar, taille_elite);
+    chrono::steady_clock::time_point dernier_point_reprise = chrono::steady_clock::now();
+    BornesInferieures bornes;
+
+    // Sauvegarde de l'état courant
+    auto sauvegarder = [&]() {
+        PointReprise p;
+        p.n = n_sommets;
+        p.empreinte = empreinte_graphe();
+        p.temps_ecoule = secondes_depuis(debut_total);
+        p.temps_total = temps_limite;
+        p.alpha = alpha;
+        p.beta = param_beta;
+        p.k = k;
+        p.temps_intensif = temps_intensification_limit;
+        p.temps_diversif = temps_diversification_limit;
+        p.adaptatif = controle_adaptatif;
+        p.ordre = ordre_renumerotation;
+        p.rho = rho;
+        p.generateur = generator;
+        p.intensification = flux_intensification;
+        p.iterations = iterations;
+        p.succes_intensification = succes_intensification;
+        p.succes_reparation = succes_reparation;
+        p.succes_diversification = succes_diversification;
+        p.controleur = controleur;
+        p.contrainte_lb = etat_contrainte_lb;
+        p.bornes = bornes;
+        p.x_bar = x_bar;
+
+        if (!ecrire_point_reprise(fichier_point_reprise, p)) {
+            JOURNAL_ERREUR << "Erreur: impossible d'ecrire le point de reprise " << fichier_point_reprise;
+        }
+        dernier_point_reprise = chrono::steady_clock::now();
+    };
+
+    if (reprise && bornes_actives) {
+        bornes = reprise->bornes;  // Multiplicateurs repris : pas de nouveau démarrage à froid
+        afficher_bornes(logFile, x_bar.score, bornes);
+    } else if (bornes_actives) {
+        rafraichir_bornes(bornes, x_bar.score, true);
+        afficher_bornes(logFile, x_bar.score, bornes);
+    }
+    chrono::steady_clock::time_point dernier_rafraichissement = chrono::steady_clock::now();
+
+    // Paramètres de ce thread : ceux de la ligne de commande tant que le contrôleur n'intervient pas
+    alpha_effectif = alpha;
+    beta_effectif = param_beta;
+    k_effectif = k;
+    double temps_intensif = temps_intensification_limit;
+    double temps_diversif = temps_diversification_limit;
+
+    // Durée d'une phase plafonnée au temps restant : une itération commencée juste avant
+    // temps_limite ne le dépasse pas (budgets courts des niveaux de -multiniveau)
+    auto temps_phase = [&](double temps) {
+        return max(0.0, min(temps, temps_limite - secondes_depuis(debut_total)));
+    };
+
+    while (true) {
+        double temps_ecoule = secondes_depuis(debut_total);
+
+        if (temps_ecoule >= temps_limite || annulation_demandee()) {
+            break;
+        }
+
+        if (bornes_actives && secondes_depuis(dernier_rafraichissement) >= periode_bornes) {
+            rafraichir_bornes(bornes, x_bar.score, false);
+            afficher_bornes(logFile, x_bar.score, bornes);
+            dernier_rafraichissement = chrono::steady_clock::now();
+        }
+
+        if (bornes_actives && calculer_gap(x_bar.score, bornes) <= gap_cible) {
+            JOURNAL(logFile) << "Gap cible atteint: arret";
+            afficher_bornes(logFile, x_bar.score, bornes);
+            break;
+        }
+
+        if (!fichier_point_reprise.empty() &&
+            secondes_depuis(dernier_point_reprise) >= periode_point_reprise) {
+            sauvegarder();
+        }
+
+        Solution x_adoptee;
+        if (rappel_adoption && rappel_adoption(x_bar.score, x_adoptee) && solution_realisable(x_adoptee)) {
+            JOURNAL(logFile) << "Cooperation: solution adoptee " << x_bar.score << " -> " << x_adoptee.score;
+            x_bar = move(x_adoptee);
+        }
+
+        iterations++;
+        long long allocations_debut = compteur_allocations();
+        int bras = -1;
+        int score_debut_iteration = x_bar.score;
+        chrono::steady_clock::time_point debut_iteration = chrono::steady_clock::now();
+        if (controle_adaptatif) {
+            bras = choisir_bras(controleur);
+            appliquer_bras(controleur.bras[bras], temps_intensif, temps_diversif, logFile);
+        }
+
+        // CORRECTION : utiliser la bonne fonction d'intensification
+        Solution x_intensif;
+        if (phase_intensification_avec_run_cplex(x_bar, temps_phase(temps_intensif), logFile, x_intensif)) {
+            int dist = distance_hamming(x_bar, x_intensif);
+            JOURNAL(logFile) << "Amelioration trouvee: " << x_intensif.score
+                             << " (distance Hamming: " << dist << ")";
+
+            if (dist <= k_effectif) {
+                x_bar = move(x_intensif);
+                succes_intensification++;
+            } else if (taille_elite > 0) {
+                // Chemins entre la solution éloignée et l'élite (dont x_bar) au lieu d'un appel CPLEX
+                Solution x_relie;
+                if (phase_path_relinking(x_intensif, elite, temps_phase(temps_diversif), logFile, x_relie)) {
+                    x_intensif = move(x_relie);
+                    succes_relinking++;
+                    succes_reparation++;
+                    JOURNAL(logFile) << "Nouvelle meilleure solution apres relinking: " << x_intensif.score;
+                }
+                x_bar = move(x_intensif);
+            } else {
+                vector<int>& age_local = arene.age;
+                age_local.assign(n_sommets, -1);
+                for (int v : x_intensif.vertices) {
+                    age_local[v] = 0;
+                }
+
+                double temps_restant = temps_phase(10.0);
+
+                Solution x_cplex;
+                // CORRECTION : utiliser run_cplex au lieu de executer_cplex
+                run_cplex(x_cplex, x_bar, age_local, temps_restant,
+                          cutoff_amelioration(x_bar), emphase_effective(emphase_reparation),
+                          cplex_abort);
+
+                // Note: run_cplex renvoie déjà une solution complète, pas besoin de fusionner
+                // x_cplex.vertices.insert(x_bar.vertices.begin(), x_bar.vertices.end());
+                x_cplex.score = calculer_score(x_cplex);
+
+                if (x_cplex.score < x_bar.score) {
+                    x_bar = move(x_cplex);
+                    succes_reparation++;
+                    JOURNAL(logFile) << "Nouvelle meilleure solution apres CPLEX: " << x_bar.score;
+                }
+            }
+        } else {
+            // Troisième phase : relinking entre x_bar et l'élite avant de diversifier
+            Solution x_relie;
+            if (elite_modifiee && phase_path_relinking(x_bar, elite, temps_phase(temps_diversif), logFile, x_relie)) {
+                x_bar = move(x_relie);
+                succes_relinking++;
+                JOURNAL(logFile) << "Relinking reussi: " << x_bar.score;
+            } else {
+                // CORRECTION : utiliser la bonne fonction de diversification
+                Solution x_diversif;
+                if (phase_diversification_avec_roulette(x_bar, temps_phase(temps_diversif), generator,
+                                                        distribution, x_diversif)) {
+                    x_bar = move(x_diversif);
+                    succes_diversification++;
+                    JOURNAL(logFile) << "Diversification reussie: " << x_bar.score;
+                }
+            }
+            elite_modifiee = false;
+        }
+        if (taille_elite > 0 && inserer_elite(elite, x_bar, taille_elite)) elite_modifiee = true;
+
+        if (bras >= 0) {
+            recompenser_bras(controleur, bras, score_debut_iteration - x_bar.score,
+                             secondes_depuis(debut_iteration), logFile);
+        }
+        if (rappel_amelioration && x_bar.score < score_debut_iteration) {
+            rappel_amelioration(x_bar);
+        }
+        if (allocations_debut >= 0) allocations_iterations += compteur_allocations() - allocations_debut;
+
+        temps_ecoule = secondes_depuis(debut_total);
+
+        if (temps_ecoule >= temps_limite) {
+            break;
+        }
+    }
+
+    JOURNAL(logFile) << "Statistiques: " << iterations << " iterations, ameliorations intensification "
+                     << succes_intensification << ", reparation " << succes_reparation
+                     << ", diversification " << succes_diversification;
+    if (taille_elite > 0) {
+        JOURNAL(logFile) << "Path relinking: " << succes_relinking << " ameliorations";
+    }
+    if (compteur_allocations() >= 0 && iterations > iterations_debut) {
+        JOURNAL(logFile) << "Allocations: " << allocations_iterations / (iterations - iterations_debut)
+                         << " par iteration, "
+                         << (reconstructions_mesurees ? allocations_reconstructions / reconstructions_mesurees : 0)
+                         << " par reconstruction de diversification (" << reconstructions_mesurees << " mesurees)";
+    }
+
+    if (!fichier_point_reprise.empty()) sauvegarder();
+
+    return x_bar;
+}
+
+
+
+// ====================================================
+// DÉCOMPOSITION EN COMPOSANTES CONNEXES
+// ====================================================
+
+/*
+ * Les contraintes PIDS ne portent que sur le voisinage d'un sommet : chaque
+ * composante connexe est un problème indépendant. Les petites composantes sont
+ * résolues exactement, les grandes par local branching en parallèle, puis les
+ * solutions partielles sont recollées.
+ */
+
+/* Fonction pour calculer les composantes connexes (parcours en largeur) */
+vector<vector<int>> composantes_connexes(int n, const CompressedAdjacency& adj) {
+    vector<vector<int>> composantes;
+    vector<bool> visite(n, false);
+
+    for (int s = 0; s < n; ++s) {
+        if (visite[s]) continue;
+
+        vector<int> composante;
+        visite[s] = true;
+        composante.push_back(s);
+
+        // La composante sert elle-même de file d'attente
+        for (size_t tete = 0; tete < composante.size(); ++tete) {
+            for (int voisin : adj[composante[tete]]) {
+                if (!visite[voisin]) {
+                    visite[voisin] = true;
+                    composante.push_back(voisin);
+                }
+            }
+        }
+        composantes.push_back(composante);
+    }
+
+    return composantes;
+}
+
+/* Fonction pour construire le sous-graphe induit par une composante (indices locaux) */
+CompressedAdjacency extraire_sous_graphe(const vector<int>& sommets, const CompressedAdjacency& adj) {
+    map<int, int> indice_local;
+    for (size_t i = 0; i < sommets.size(); ++i) {
+        indice_local[sommets[i]] = i;
+    }
+
+    vector<uint64_t> debut(sommets.size() + 1, 0);
+    for (size_t i = 0; i < sommets.size(); ++i) {
+        debut[i + 1] = debut[i] + adj.degree(sommets[i]);
+    }
+    vector<int> cibles(debut.back());
+    for (size_t i = 0; i < sommets.size(); ++i) {
+        uint64_t e = debut[i];
+        for (int voisin : adj[sommets[i]]) cibles[e++] = indice_local[voisin];
+    }
+
+    CompressedAdjacency sous_graphe;
+    sous_graphe.build(sommets.size(), debut, cibles);
+    return sous_graphe;
+}
+
+/*
+ * Résolution exacte d'une petite composante par énumération des sous-ensembles
+ * par cardinal croissant : le premier ensemble réalisable est optimal.
+ * Une composante réduite à un sommet isolé donne l'ensemble vide (seuil nul).
+ */
+Solution resoudre_composante_exacte(const vector<int>& sommets, const CompressedAdjacency& adj) {
+    int s = sommets.size();
+    CompressedAdjacency sous_graphe = extraire_sous_graphe(sommets, adj);
+
+    vector<unsigned int> masque_voisins(s, 0);
+    vector<int> seuil(s, 0);
+    for (int i = 0; i < s; ++i) {
+        for (int j : sous_graphe[i]) masque_voisins[i] |= (1u << j);
+        seuil[i] = seuils[sommets[i]];
+    }
+
+    unsigned int meilleur_masque = (s == 32) ? 0xFFFFFFFFu : ((1u << s) - 1);
+    bool trouve = false;
+
+    for (int card = 0; card <= s && !trouve; ++card) {
+        // Parcours des masques de cardinal card (astuce de Gosper)
+        unsigned long long masque = (card == 0) ? 0ULL : ((1ULL << card) - 1);
+        while (masque < (1ULL << s)) {
+            unsigned int m = (unsigned int)masque;
+            bool realisable = true;
+            for (int i = 0; i < s && realisable; ++i) {
+                if (!(m & (1u << i)) && __builtin_popcount(masque_voisins[i] & m) < seuil[i]) {
+                    realisable = false;
+                }
+            }
+            if (realisable) {
+                meilleur_masque = m;
+                trouve = true;
+                break;
+            }
+            if (card == 0) break;
+            unsigned long long c = masque & (~masque + 1);
+            unsigned long long r = masque + c;
+            masque = (((r ^ masque) >> 2) / c) | r;
+        }
+    }
+
+    Solution sol;
+    for (int i = 0; i < s; ++i) {
+        if (meilleur_masque & (1u << i)) sol.vertices.insert(sommets[i]);
+    }
+    sol.score = sol.vertices.size();
+    return sol;
+}
+
+/* Algorithme de Local Branching appliqué composante par composante */
+Solution resoudre_par_composantes(LogFile& logFile) {
+
+    chrono::steady_clock::time_point debut = chrono::steady_clock::now();
+
+    vector<vector<int>> composantes = composantes_connexes(n_sommets, voisins);
+
+    vector<vector<int>> petites, grandes;
+    vector<int> isoles_forces;  // Sommets isolés de seuil imposé non nul : toujours choisis
+    int n_isoles = 0;
+    long long somme_tailles_grandes = 0;
+    for (const vector<int>& c : composantes) {
+        if (c.size() == 1) {
+            n_isoles++;  // Sommet isolé : dominé sans être choisi (seuil nul)
+            if (seuils[c[0]] > 0) isoles_forces.push_back(c[0]);
+        } else if ((int)c.size() <= taille_max_exacte && c.size() <= 32) {
+            petites.push_back(c);
+        } else {
+            grandes.push_back(c);
+            somme_tailles_grandes += c.size();
+        }
+    }
+
+    // Les plus grandes composantes en premier (meilleur équilibrage)
+    sort(grandes.begin(), grandes.end(),
+         [](const vector<int>& a, const vector<int>& b) { return a.size() > b.size(); });
+
+    JOURNAL(logFile) << "Composantes connexes: " << composantes.size()
+                     << " (isoles: " << n_isoles << ", exactes: " << petites.size()
+                     << ", local branching: " << grandes.size() << ")";
+
+    Solution solution_globale;
+    solution_globale.vertices.insert(isoles_forces.begin(), isoles_forces.end());
+
+    // 1. Petites composantes : énumération exacte
+    for (const vector<int>& c : petites) {
+        Solution sol = resoudre_composante_exacte(c, voisins);
+        solution_globale.vertices.insert(sol.vertices.begin(), sol.vertices.end());
+    }
+
+    // 2. Grandes composantes : local branching en parallèle, budget proportionnel à la taille
+    int n_workers = max(1, n_threads);
+    vector<Solution> solutions_grandes(grandes.size());
+    const CompressedAdjacency& graphe_complet = voisins;
+    const vector<int>& seuils_complets = seuils_imposes;
+
+    executer_en_parallele(grandes.size(), n_workers, [&](int t) {
+        const vector<int>& c = grandes[t];
+
+        double part = temps_total_limit * n_workers * c.size() / (double)somme_tailles_grandes;
+        double budget = min(part, temps_total_limit - secondes_depuis(debut));
+        if (budget < 1.0) budget = 1.0;
+
+        // Lier ce thread au sous-graphe de la composante
+        n_sommets = c.size();
+        voisins = extraire_sous_graphe(c, graphe_complet);
+        seuils_imposes.clear();
+        if (!seuils_complets.empty()) {
+            for (int v : c) seuils_imposes.push_back(seuils_complets[v]);
+        }
+        preparer_graphe();
+        etat_contrainte_lb = EtatContrainteLB();  // Le worker peut avoir traité une autre composante
+        prefixe_fichiers_cplex = "cc" + to_string(t) + "_";
+        flux_racine = FluxAleatoire(graine_globale).derive(t + 1);  // Indépendant du thread qui exécute t
+
+        LogFile log_composante;  // Non ouvert (console seule) : seul le bilan va dans le fichier
+        Solution sol_locale = algorithme_local_branching(log_composante, budget);
+
+        for (int v : sol_locale.vertices) {
+            solutions_grandes[t].vertices.insert(c[v]);
+        }
+        solutions_grandes[t].score = sol_locale.score;
+    });
+
+    for (size_t t = 0; t < grandes.size(); ++t) {
+        JOURNAL(logFile) << "Composante " << t << " (" << grandes[t].size() << " sommets): score = "
+                         << solutions_grandes[t].score;
+        solution_globale.vertices.insert(solutions_grandes[t].vertices.begin(),
+                                         solutions_grandes[t].vertices.end());
+    }
+
+    // 3. Recollement
+    solution_globale.score = calculer_score(solution_globale);
+    return solution_globale;
+}
+
+
+
+
+// ====================================================
+// RÉSOLUTION EXACTE À PARTIR DE L'INCUMBENT
+// ====================================================
+
+/*
+ * Mode combiné heuristique -> exact : le modèle complet est résolu par CPLEX
+ * avec la meilleure solution du local branching comme MIP start et sa valeur
+ * comme cutoff (les noeuds qui ne peuvent pas faire mieux sont élagués).
+ */
+Solution resolution_exacte(Solution& depart, double temps_limit, LogFile& logFile) {
+    JOURNAL(logFile) << "Resolution exacte (" << temps_limit << " s) a partir de: " << depart.score;
+
+    vector<int> age(n_sommets, 0);  // Toutes les variables libres
+    bool warm_start_sauve = warm_start;
+    warm_start = true;
+
+    Solution x_exacte;
+    run_cplex(x_exacte, depart, age, temps_limit, depart.score, emphase_exacte);
+    warm_start = warm_start_sauve;
+
+    bool solution_valide = (x_exacte.score != std::numeric_limits<int>::max()) &&
+                           solution_realisable(x_exacte);
+
+    JOURNAL(logFile) << (solveur_natif ? "Statut B&B natif: " : "Statut CPLEX: ") << dernier_statut_cplex;
+
+    if (solution_valide && x_exacte.score < depart.score) {
+        JOURNAL(logFile) << "Amelioration exacte: " << x_exacte.score;
+        return x_exacte;
+    }
+    return depart;
+}
+
+
+
+
+
+
+
+
+// ====================================================
+// RENUMÉROTATION DES SOMMETS (LOCALITÉ MÉMOIRE)
+// ====================================================
+
+/*
+ * Les identifiants des fichiers d'entrée suivent l'ordre du générateur : les
+ * parcours de voisinage (couverture, est_domine, roulette) sautent dans toute la
+ * mémoire. Une renumérotation au chargement rapproche les sommets voisins :
+ *  - rcm   : Cuthill-McKee inversé (largeur de bande minimale) ;
+ *  - degre : degrés décroissants (les sommets les plus parcourus en tête) ;
+ *  - bfs   : ordre de parcours en largeur depuis le sommet de plus fort degré.
+ * ordre[nouveau] = ancien. Le graphe interne est renuméroté en place, les
+ * solutions sont traduites vers les identifiants d'origine avant l'affichage.
+ */
+
+/* Parcours en largeur de chaque composante ; voisins visités par degré croissant si par_degre */
+vector<int> ordre_parcours(bool depart_degre_min, bool par_degre) {
+    vector<int> sommets(n_sommets);
+    for (int i = 0; i < n_sommets; ++i) sommets[i] = i;
+    stable_sort(sommets.begin(), sommets.end(), [&](int a, int b) {
+        return depart_degre_min ? voisins[a].size() < voisins[b].size()
+                                : voisins[a].size() > voisins[b].size();
+    });
+
+    vector<int> ordre;
+    ordre.reserve(n_sommets);
+    vector<char> visite(n_sommets, 0);
+    vector<int> suivants;
+    for (int depart : sommets) {
+        if (visite[depart]) continue;
+        visite[depart] = 1;
+        size_t tete = ordre.size();
+        ordre.push_back(depart);
+        while (tete < ordre.size()) {
+            int v = ordre[tete++];
+            suivants.clear();
+            for (int u : voisins[v]) {
+                if (!visite[u]) {
+                    visite[u] = 1;
+                    suivants.push_back(u);
+                }
+            }
+            if (par_degre) {
+                stable_sort(suivants.begin(), suivants.end(),
+                            [&](int a, int b) { return voisins[a].size() < voisins[b].size(); });
+            }
+            ordre.insert(ordre.end(), suivants.begin(), suivants.end());
+        }
+    }
+    return ordre;
+}
+
+vector<int> calculer_ordre(int type) {
+    vector<int> ordre;
+    if (type == ORDRE_RCM) {
+        ordre = ordre_parcours(true, true);
+        reverse(ordre.begin(), ordre.end());
+    } else if (type == ORDRE_BFS) {
+        ordre = ordre_parcours(false, false);
+    } else {
+        ordre.resize(n_sommets);
+        for (int i = 0; i < n_sommets; ++i) ordre[i] = i;
+        if (type == ORDRE_DEGRE) {
+            stable_sort(ordre.begin(), ordre.end(),
+                        [&](int a, int b) { return voisins[a].size() > voisins[b].size(); });
+        }
+    }
+    return ordre;
+}
+
+vector<int> inverser_ordre(const vector<int>& ordre) {
+    vector<int> inverse(ordre.size());
+    for (size_t i = 0; i < ordre.size(); ++i) inverse[ordre[i]] = i;
+    return inverse;
+}
+
+/* Remplace le graphe du thread par sa version renumérotée (listes réencodées dans le nouvel ordre) */
+void renumeroter_graphe(const vector<int>& ordre) {
+    vector<int> nouveau = inverser_ordre(ordre);
+    vector<uint64_t> debut(n_sommets + 1, 0);
+    for (int i = 0; i < n_sommets; ++i) debut[i + 1] = debut[i] + voisins.degree(ordre[i]);
+    vector<int> cibles(debut[n_sommets]);
+    for (int i = 0; i < n_sommets; ++i) {
+        uint64_t e = debut[i];
+        for (int u : voisins[ordre[i]]) cibles[e++] = nouveau[u];
+    }
+    CompressedAdjacency renumerote;
+    renumerote.build(n_sommets, debut, cibles);
+    voisins.swap(renumerote);
+    if ((int)seuils_imposes.size() == n_sommets) {
+        vector<int> permutes(n_sommets);
+        for (int i = 0; i < n_sommets; ++i) permutes[i] = seuils_imposes[ordre[i]];
+        seuils_imposes.swap(permutes);
+    }
+    preparer_graphe();
+}
+
+/* Solution exprimée avec table[id] comme identifiants */
+Solution renumeroter_solution(const Solution& sol, const vector<int>& table) {
+    Solution resultat;
+    for (int v : sol.vertices) resultat.vertices.insert(table[v]);
+    resultat.score = sol.score;
+    return resultat;
+}
+
+/*
+ * Banc d'essai des noyaux de couverture pour chaque ordre : calcul complet de la
+ * couverture, puis mises à jour (ajout / retrait d'un sommet et de ses voisins)
+ * dans l'ordre des identifiants. Même solution pour tous les ordres. Le noyau
+ * parcourt une copie décodée et contiguë des listes d'adjacence, pour mesurer
+ * l'effet de l'ordre sur les accès à la couverture et non le coût du décodage.
+ * Les défauts de cache se mesurent avec perf :
+ *   perf stat -e cache-misses ./lb_pids -i <graphe> -bench_ordre 100
+ */
+void banc_ordres(int repetitions) {
+    FluxAleatoire flux(graine_globale);
+    vector<char> dans_sol_origine(n_sommets, 0);
+    for (int i = 0; i < n_sommets; ++i) dans_sol_origine[i] = flux.uniforme() < 0.4;
+
+    for (int type = 0; type < N_ORDRES; ++type) {
+        vector<int> ordre = calculer_ordre(type);
+        renumeroter_graphe(ordre);
+
+        vector<char> dans_sol(n_sommets);
+        for (int i = 0; i < n_sommets; ++i) dans_sol[i] = dans_sol_origine[ordre[i]];
+
+        long long bande = 0;
+        for (int i = 0; i < n_sommets; ++i) {
+            if (!voisins[i].empty()) {
+                bande = max(bande, (long long)max(i - voisins[i].front(), voisins[i].back() - i));
+            }
+        }
+
+        vector<uint64_t> debut_adj(n_sommets + 1, 0);
+        vector<int> adj;
+        for (int i = 0; i < n_sommets; ++i) {
+            adj.insert(adj.end(), voisins[i].begin(), voisins[i].end());
+            debut_adj[i + 1] = adj.size();
+        }
+
+        long long controle = 0;
+        vector<int> couverture(n_sommets);
+        chrono::steady_clock::time_point debut = chrono::steady_clock::now();
+        for (int r = 0; r < repetitions; ++r) {
+            fill(couverture.begin(), couverture.end(), 0);
+            for (int v = 0; v < n_sommets; ++v) {
+                if (!dans_sol[v]) continue;
+                for (uint64_t e = debut_adj[v]; e < debut_adj[v + 1]; ++e) couverture[adj[e]]++;
+            }
+            for (int v = 0; v < n_sommets; ++v) {
+                int signe = dans_sol[v] ? -1 : 1;
+                for (uint64_t e = debut_adj[v]; e < debut_adj[v + 1]; ++e) couverture[adj[e]] += signe;
+                for (uint64_t e = debut_adj[v]; e < debut_adj[v + 1]; ++e) couverture[adj[e]] -= signe;
+            }
+            controle += couverture[r % n_sommets];
+        }
+        double ms = 1000.0 * secondes_depuis(debut) / repetitions;
+
+        JOURNAL_CONSOLE << "Ordre " << setw(6) << noms_ordre[type] << ": " << fixed << setprecision(3) << ms
+                        << " ms par passe, largeur de bande " << bande << " (controle " << controle << ")";
+
+        renumeroter_graphe(inverser_ordre(ordre));
+    }
+}
+
+
+
+
+// ====================================================
+// RÉSOLUTION INCRÉMENTALE (GRAPHE DYNAMIQUE)
+// ====================================================
+
+/*
+ * Entre deux résolutions, le graphe ne change que de quelques arêtes : la solution
+ * précédente est lue, le delta est appliqué en place sur voisins, seuls les sommets
+ * dont la domination a changé sont réparés, puis le local branching repart de la
+ * solution réparée avec un budget court.
+ *
+ * Fichier delta : une arête par ligne, "+ u v" (ajout) ou "- u v" (suppression),
+ * sommets numérotés à partir de 0 comme dans "Sommets selectionnes". '#' : commentaire.
+ */
+
+/*
+ * Solution précédente : fichier OUTPUT_LocalBranching (ligne "Sommets selectionnes:")
+ * ou simple liste de sommets.
+ */
+bool lire_solution(const string& nom_fichier, int n, Solution& sol) {
+    ifstream fichier(nom_fichier.c_str());
+    if (!fichier.is_open()) return false;
+
+    string ligne, contenu;
+    bool sortie_lb = false;
+    while (getline(fichier, ligne)) {
+        size_t pos = ligne.find("Sommets selectionnes:");
+        if (pos != string::npos) {
+            contenu = ligne.substr(pos + strlen("Sommets selectionnes:"));
+            sortie_lb = true;
+        } else if (!sortie_lb) {
+            contenu += " " + ligne;
+        }
+    }
+
+    sol.vertices.clear();
+    istringstream iss(contenu);
+    int v;
+    while (iss >> v) {
+        if (v < 0 || v >= n) return false;
+        sol.vertices.insert(v);
+    }
+    sol.score = sol.vertices.size();
+    return true;
+}
+
+/*
+ * Applique le delta sur le graphe du thread ; touches reçoit les extrémités des arêtes
+ * modifiées. Les listes des sommets concernés sont décodées, modifiées, puis réencodées
+ * ensemble à la fin (les listes compressées ne se modifient pas sur place).
+ */
+bool appliquer_delta(const string& nom_fichier, vector<int>& touches, int& n_ajouts, int& n_suppressions) {
+    ifstream fichier(nom_fichier.c_str());
+    if (!fichier.is_open()) return false;
+
+    map<int, vector<int>> listes;
+    auto liste = [&](int v) -> vector<int>& {
+        map<int, vector<int>>::iterator it = listes.find(v);
+        if (it == listes.end()) it = listes.insert(make_pair(v, voisins.list(v))).first;
+        return it->second;
+    };
+    auto inserer = [&](int u, int v) {
+        vector<int>& l = liste(u);
+        vector<int>::iterator it = lower_bound(l.begin(), l.end(), v);
+        if (it != l.end() && *it == v) return false;
+        l.insert(it, v);
+        return true;
+    };
+    auto effacer = [&](int u, int v) {
+        vector<int>& l = liste(u);
+        vector<int>::iterator it = lower_bound(l.begin(), l.end(), v);
+        if (it == l.end() || *it != v) return false;
+        l.erase(it);
+        return true;
+    };
+
+    vector<char> marque(n_sommets, 0);
+    n_ajouts = n_suppressions = 0;
+    string ligne;
+    int numero = 0;
+    while (getline(fichier, ligne)) {
+        numero++;
+        istringstream iss(ligne);
+        char op;
+        int u, v;
+        if (!(iss >> op) || op == '#') continue;
+        if (!(iss >> u >> v) || (op != '+' && op != '-') ||
+            u < 0 || v < 0 || u >= n_sommets || v >= n_sommets || u == v) {
+            JOURNAL_ERREUR << "Erreur: ligne " << numero << " du delta invalide: " << ligne;
+            return false;
+        }
+
+        bool change;
+        if (op == '+') {
+            change = inserer(u, v);
+            inserer(v, u);
+            if (change) n_ajouts++;
+        } else {
+            change = effacer(u, v);
+            effacer(v, u);
+            if (change) n_suppressions++;
+        }
+        if (change) {
+            if (!marque[u]) { marque[u] = 1; touches.push_back(u); }
+            if (!marque[v]) { marque[v] = 1; touches.push_back(v); }
+        }
+    }
+    voisins.replace(listes);
+    preparer_graphe();
+    return true;
+}
+
+/*
+ * Réparation locale : seuls les sommets touchés par le delta ont pu perdre leur
+ * domination (degré ou couverture modifiés). Ajouts gloutons du sommet qui réduit
+ * le plus les besoins restants, puis retrait des sommets devenus redondants dans
+ * le voisinage à distance 2 des sommets touchés.
+ */
+Solution reparer_solution(const Solution& precedente, const vector<int>& touches) {
+    Solution sol = precedente;
+    vector<char> dans_sol;
+    vector<int> couverture;
+    indicatrice_solution(sol, dans_sol);
+    calculer_couverture(dans_sol, couverture);
+
+    // besoin(v) : voisins manquants dans la solution pour dominer v (0 si v est dominé)
+    auto besoin = [&](int v) {
+        if (dans_sol[v]) return 0;
+        return max(0, seuils[v] - couverture[v]);
+    };
+    auto ajouter = [&](int u) {
+        dans_sol[u] = 1;
+        sol.vertices.insert(u);
+        for (int w : voisins[u]) couverture[w]++;
+    };
+
+    // 1. Ajouts gloutons parmi les voisinages fermés des sommets non dominés
+    vector<int> non_domines;
+    for (int v : touches) {
+        if (besoin(v) > 0) non_domines.push_back(v);
+    }
+    while (!non_domines.empty()) {
+        int meilleur = -1, meilleur_gain = 0;
+        for (int v : non_domines) {
+            if (besoin(v) == 0) continue;
+            for (int u : voisins[v]) {
+                if (dans_sol[u]) continue;
+                int gain = besoin(u);
+                for (int w : voisins[u]) gain += besoin(w) > 0 ? 1 : 0;
+                if (gain > meilleur_gain) { meilleur_gain = gain; meilleur = u; }
+            }
+            if (besoin(v) > meilleur_gain) { meilleur_gain = besoin(v); meilleur = v; }
+        }
+        if (meilleur < 0) break;
+        ajouter(meilleur);
+
+        vector<int> restants;
+        for (int v : non_domines) {
+            if (besoin(v) > 0) restants.push_back(v);
+        }
+        non_domines.swap(restants);
+    }
+
+    // 2. Retrait des sommets redondants près du delta
+    vector<char> zone(n_sommets, 0);
+    vector<int> candidats;
+    for (int v : touches) {
+        if (!zone[v]) { zone[v] = 1; candidats.push_back(v); }
+        for (int u : voisins[v]) {
+            if (!zone[u]) { zone[u] = 1; candidats.push_back(u); }
+        }
+    }
+    retirer_redondants(candidats, dans_sol, couverture, sol);
+
+    sol.score = sol.vertices.size();
+    return sol;
+}
+
+/*
+ * Graphe mis à jour, au format d'entrée en liste d'arêtes (n, m, puis "u v" numérotés
+ * à partir de 1), pour le delta suivant : la matrice n x n ne tient pas pour les grands graphes.
+ */
+bool ecrire_graphe(const string& nom_fichier) {
+    BufferedWriter out;
+    if (!out.open(nom_fichier)) return false;
+    out.putInt(n_sommets).put('\n').putInt(nombre_aretes()).put('\n');
+    for (int i = 0; i < n_sommets; ++i) {
+        for (int j : voisins[i]) {
+            if (j > i) out.putInt(i + 1).put(' ').putInt(j + 1).put('\n');
+        }
+    }
+    return out.close();
+}
+
+
+
+
+// ====================================================
+// RÉSOLUTION MULTINIVEAU
+// ====================================================
+
+/*
+ * Sur les très grands graphes, la structure globale d'une bonne solution se voit
+ * déjà sur un graphe contracté. Le graphe est contracté niveau par niveau jusqu'à
+ * taille_multiniveau sommets ; le niveau le plus grossier est résolu par le local
+ * branching, puis chaque solution est projetée sur le niveau plus fin (un sommet
+ * contracté choisi : tous ses sommets choisis), complétée, et raffinée par le local
+ * branching (intensification et réparation de diversification) à partir de la
+ * projection. Le budget restant est partagé entre les niveaux au prorata de leur
+ * taille : la somme des tailles reste inférieure à quelques fois n.
+ */
+
+struct NiveauMultiniveau {
+    int n;
+    CompressedAdjacency voisins;
+    vector<int> seuils_imposes;
+    vector<int> parent;  // Sommet de ce niveau -> sommet du niveau plus grossier
+};
+
+/* Échange le graphe du thread avec celui du niveau (à appeler deux fois pour le rendre) */
+void echanger_niveau(NiveauMultiniveau& niveau) {
+    swap(n_sommets, niveau.n);
+    voisins.swap(niveau.voisins);
+    seuils_imposes.swap(niveau.seuils_imposes);
+    etat_contrainte_lb = EtatContrainteLB();
+    preparer_graphe();
+}
+
+/*
+ * Contraction du graphe du thread : parent[v] = sommet grossier de v, retourne le
+ * nombre de sommets grossiers. Les sommets, par degré croissant, sont couplés avec
+ * leur voisin libre de plus petit degré (les sommets de fort degré, souvent choisis,
+ * restent plutôt seuls) ; les sommets restés seuls sont ensuite regroupés par
+ * paires qui partagent un voisin. Un sommet grossier c de degré d(c) reçoit le
+ * seuil ceil(somme h(v) * d(c) / somme deg(v)) sur ses sommets v (au plus d(c)) :
+ * la proportion de voisins à choisir est celle du groupe.
+ */
+int contracter_graphe(FluxAleatoire& flux, vector<int>& parent, CompressedAdjacency& grossier,
+                      vector<int>& seuils_grossiers) {
+    vector<int> ordre(n_sommets);
+    for (int i = 0; i < n_sommets; ++i) ordre[i] = i;
+    for (int i = 0; i < n_sommets; ++i) swap(ordre[i], ordre[i + flux.entier(n_sommets - i)]);
+    stable_sort(ordre.begin(), ordre.end(),
+                [](int a, int b) { return voisins.degree(a) < voisins.degree(b); });
+
+    // 1. Couplage
+    vector<int> partenaire(n_sommets, -1);
+    vector<char> couple(n_sommets, 0);
+    for (int u : ordre) {
+        if (couple[u]) continue;
+        int meilleur = -1;
+        for (int v : voisins[u]) {
+            if (!couple[v] && (meilleur < 0 || voisins.degree(v) < voisins.degree(meilleur))) meilleur = v;
+        }
+        if (meilleur < 0) continue;
+        couple[u] = couple[meilleur] = 1;
+        partenaire[u] = meilleur;
+        partenaire[meilleur] = u;
+    }
+
+    // 2. Sommets seuls ayant un voisin commun (le premier de leur liste)
+    vector<int> en_attente(n_sommets, -1);
+    for (int u : ordre) {
+        if (couple[u] || voisins[u].empty()) continue;
+        int w = voisins[u].front();
+        int v = en_attente[w];
+        if (v >= 0 && !couple[v]) {
+            couple[u] = couple[v] = 1;
+            partenaire[u] = v;
+            partenaire[v] = u;
+            en_attente[w] = -1;
+        } else {
+            en_attente[w] = u;
+        }
+    }
+
+    // 3. Numérotation dans l'ordre du plus petit sommet de chaque groupe (localité préservée)
+    parent.assign(n_sommets, -1);
+    int n_grossier = 0;
+    for (int v = 0; v < n_sommets; ++v) {
+        if (parent[v] >= 0) continue;
+        parent[v] = n_grossier;
+        if (partenaire[v] >= 0) parent[partenaire[v]] = n_grossier;
+        n_grossier++;
+    }
+
+    // 4. Arêtes entre groupes (build trie, supprime les doublons et les boucles internes)
+    vector<uint64_t> debut(n_grossier + 1, 0);
+    for (int v = 0; v < n_sommets; ++v) debut[parent[v] + 1] += voisins.degree(v);
+    for (int c = 0; c < n_grossier; ++c) debut[c + 1] += debut[c];
+    vector<uint64_t> position(debut.begin(), debut.end() - 1);
+    vector<int> cibles(debut.back());
+    for (int v = 0; v < n_sommets; ++v) {
+        for (int u : voisins[v]) cibles[position[parent[v]]++] = parent[u];
+    }
+    vector<uint64_t>().swap(position);
+    grossier.build(n_grossier, debut, cibles);
+
+    // 5. Seuils agrégés
+    vector<long long> somme_seuils(n_grossier, 0), somme_degres(n_grossier, 0);
+    for (int v = 0; v < n_sommets; ++v) {
+        somme_seuils[parent[v]] += seuils[v];
+        somme_degres[parent[v]] += voisins.degree(v);
+    }
+    seuils_grossiers.resize(n_grossier);
+    for (int c = 0; c < n_grossier; ++c) {
+        int d = grossier.degree(c);
+        seuils_grossiers[c] = somme_degres[c] == 0 ? 0
+                            : min(d, (int)ceil((double)somme_seuils[c] * d / somme_degres[c] - 1e-9));
+    }
+    return n_grossier;
+}
+
+/*
+ * Solution du niveau plus grossier -> graphe du thread : les sommets dont le parent
+ * est choisi. Chaque sommet resté non dominé est complété par ajouts gloutons dans
+ * son voisinage fermé, comme dans reparer_solution mais sommet par sommet (linéaire
+ * en le nombre de non dominés), puis les sommets redondants sont retirés.
+ */
+Solution projeter_solution(const Solution& grossiere, int n_grossier, const vector<int>& parent) {
+    vector<char> choisi(n_grossier, 0);
+    for (int c : grossiere.vertices) choisi[c] = 1;
+
+    Solution sol;
+    vector<char> dans_sol(n_sommets, 0);
+    for (int v = 0; v < n_sommets; ++v) {
+        if (choisi[parent[v]]) {
+            dans_sol[v] = 1;
+            sol.vertices.insert(sol.vertices.end(), v);
+        }
+    }
+    vector<int> couverture;
+    calculer_couverture(dans_sol, couverture);
+
+    auto besoin = [&](int v) {
+        if (dans_sol[v]) return 0;
+        return max(0, seuils[v] - couverture[v]);
+    };
+    for (int v = 0; v < n_sommets; ++v) {
+        while (besoin(v) > 0) {
+            int meilleur = v, meilleur_gain = besoin(v);
+            for (int u : voisins[v]) {
+                if (dans_sol[u]) continue;
+                int gain = besoin(u);
+                for (int w : voisins[u]) gain += besoin(w) > 0 ? 1 : 0;
+                if (gain > meilleur_gain) { meilleur_gain = gain; meilleur = u; }
+            }
+            dans_sol[meilleur] = 1;
+            sol.vertices.insert(meilleur);
+            for (int w : voisins[meilleur]) couverture[w]++;
+        }
+    }
+
+    vector<int> candidats(sol.vertices.begin(), sol.vertices.end());
+    stable_sort(candidats.begin(), candidats.end(),
+                [](int a, int b) { return voisins.degree(a) < voisins.degree(b); });
+    retirer_redondants(candidats, dans_sol, couverture, sol);
+    sol.score = sol.vertices.size();
+    return sol;
+}
+
+/* Contraction, résolution du niveau le plus grossier, puis projection et raffinement niveau par niveau */
+Solution resoudre_multiniveau(LogFile& logFile) {
+
+    chrono::steady_clock::time_point debut = chrono::steady_clock::now();
+    FluxAleatoire flux = flux_racine.derive(FLUX_CONTRACTION);
+
+    // 1. Contraction : niveaux[l] garde le graphe du niveau l, le thread travaille sur le plus grossier
+    vector<NiveauMultiniveau> niveaux;
+    while (n_sommets > taille_multiniveau) {
+        NiveauMultiniveau niveau;
+        niveau.n = contracter_graphe(flux, niveau.parent, niveau.voisins, niveau.seuils_imposes);
+        if (niveau.n > 0.9 * n_sommets) break;  // Presque plus de couplages (étoiles) : inutile d'aller plus loin
+
+        echanger_niveau(niveau);
+        niveaux.push_back(move(niveau));
+        JOURNAL(logFile) << "Contraction: niveau " << niveaux.size() << ", " << n_sommets << " sommets, "
+                         << nombre_aretes() << " aretes";
+    }
+    JOURNAL(logFile) << "Multiniveau: " << niveaux.size() << " contractions en "
+                     << 1000.0 * secondes_depuis(debut) << " ms";
+
+    long long tailles_restantes = n_sommets;
+    for (const NiveauMultiniveau& niveau : niveaux) tailles_restantes += niveau.n;
+
+    // Budgets courts par niveau : -ti / -td plafonnés à la moitié du budget (une itération tient dans le
+    // budget) ; ni bornes inférieures ni point de reprise sur les niveaux grossiers
+    double ti_initial = temps_intensification_limit, td_initial = temps_diversification_limit;
+    string point_reprise = fichier_point_reprise;
+    fichier_point_reprise.clear();
+
+    auto raffiner = [&](int l, const Solution* depart) {
+        double budget = (temps_total_limit - secondes_depuis(debut)) * n_sommets / tailles_restantes;
+        tailles_restantes -= n_sommets;
+        temps_intensification_limit = min(ti_initial, max(budget, 0.0) / 2);
+        temps_diversification_limit = min(td_initial, max(budget, 0.0) / 2);
+        bornes_actives = (l == 0);
+        if (l == 0) fichier_point_reprise = point_reprise;
+
+        chrono::steady_clock::time_point debut_niveau = chrono::steady_clock::now();
+        LogFile log_niveau;  // Non ouvert (console seule) : seul le bilan des niveaux grossiers va dans le fichier
+        Solution sol = (budget <= 0.0 && depart) ? *depart
+                     : algorithme_local_branching(l == 0 ? logFile : log_niveau, budget, NULL, depart);
+        JOURNAL(logFile) << "Niveau " << l << " (" << n_sommets << " sommets): "
+                         << (depart ? "projection " + to_string(depart->score) + " -> " : string())
+                         << "score " << sol.score << " en " << secondes_depuis(debut_niveau) << " s";
+        return sol;
+    };
+
+    // 2. Niveau le plus grossier : heuristique de roulette puis local branching
+    Solution sol = raffiner(niveaux.size(), NULL);
+
+    // 3. Projection et raffinement jusqu'au graphe d'origine
+    for (int l = (int)niveaux.size() - 1; l >= 0; --l) {
+        int n_grossier = n_sommets;
+        echanger_niveau(niveaux[l]);
+        niveaux[l].voisins = CompressedAdjacency();  // Graphe grossier rendu : plus utile
+        Solution projetee = projeter_solution(sol, n_grossier, niveaux[l].parent);
+        niveaux[l].parent.clear();
+        niveaux[l].parent.shrink_to_fit();
+        sol = raffiner(l, &projetee);
+    }
+
+    temps_intensification_limit = ti_initial;
+    temps_diversification_limit = td_initial;
+    bornes_actives = true;
+    fichier_point_reprise = point_reprise;
+    return sol;
+}
+
+
+
+
+// ====================================================
+// MODE SERVEUR (SOCKET UNIX)
+// ====================================================
+
+#ifndef _WIN32
+
+/*
+ * lb_pids -serve <socket> : processus résident qui garde les graphes chargés et les
+ * meilleures solutions de chaque instance entre les requêtes. Protocole texte, une
+ * requête par ligne. Chaque client a son thread (paramètres de la ligne de commande,
+ * fichiers CPLEX propres) ; DELTA et RESOUDRE sur une même instance passent l'un
+ * après l'autre, sur des instances différentes en parallèle :
+ *
+ *   CHARGER <id> <fichier>           graphe au format d'entrée (remplace l'instance id)
+ *   DELTA <id> <fichier>             delta d'arêtes (voir -delta) ; l'élite est réparée
+ *   RESOUDRE <id> <temps> [cle=valeur ...]
+ *        cles : seed, a, b, k, ti, td, depart (sommets séparés par des virgules)
+ *        réponses : "AMELIORATION <score> <sommets>" à chaque amélioration,
+ *                   puis "FIN <score> <sommets>"
+ *   LISTE                            instances chargées
+ *   QUITTER                          ferme la connexion
+ *   ARRET                            arrête le serveur (résolutions en cours interrompues)
+ *
+ * Les erreurs sont renvoyées sur une ligne "ERREUR <message>".
+ */
+
+const int taille_elite_serveur = 5;
+
+struct InstanceServeur {
+    int n;
+    CompressedAdjacency voisins;
+    vector<Solution> elite;  // Meilleures solutions connues, score croissant
+    mutex verrou;            // Graphe et élite ; tenu pendant toute une requête
+};
+
+struct EtatServeur {
+    mutex verrou;  // instances (la table, pas leur contenu), clients, n_clients
+    condition_variable fin_client;
+    map<string, InstanceServeur> instances;
+    set<int> clients;  // Sockets ouvertes, coupées par ARRET
+    int n_clients;
+    atomic<bool> arret;
+    int serveur;
+    ParametresPIDS parametres;  // Ligne de commande, installés dans chaque thread client
+
+    EtatServeur() : n_clients(0), arret(false), serveur(-1) {}
+};
+
+/* Instance id, créée vide si absente ; NULL si absente et creer est faux */
+InstanceServeur* trouver_instance(EtatServeur& etat, const string& id, bool creer) {
+    lock_guard<mutex> verrou(etat.verrou);
+    map<string, InstanceServeur>::iterator it = etat.instances.find(id);
+    if (it != etat.instances.end()) return &it->second;
+    return creer ? &etat.instances[id] : NULL;
+}
+
+/* Échange le graphe du thread avec celui de l'instance (à appeler deux fois pour le rendre) */
+void echanger_graphe(InstanceServeur& inst) {
+    swap(n_sommets, inst.n);
+    voisins.swap(inst.voisins);
+    etat_contrainte_lb = EtatContrainteLB();
+    preparer_graphe();
+}
+
+string solution_en_ligne(const Solution& sol) {
+    ostringstream oss;
+    oss << sol.score;
+    for (int v : sol.vertices) oss << " " << v;
+    return oss.str();
+}
+
+bool envoyer_ligne(int client, const string& ligne) {
+    string message = ligne + "\n";
+    size_t envoye = 0;
+    while (envoye < message.size()) {
+        ssize_t r = send(client, message.data() + envoye, message.size() - envoye, MSG_NOSIGNAL);
+        if (r <= 0) return false;
+        envoye += r;
+    }
+    return true;
+}
+
+/* Lecture d'une ligne ; tampon garde ce qui a été reçu au-delà du '\n' */
+bool recevoir_ligne(int client, string& tampon, string& ligne) {
+    size_t fin;
+    while ((fin = tampon.find('\n')) == string::npos) {
+        char bloc[4096];
+        ssize_t r = recv(client, bloc, sizeof(bloc), 0);
+        if (r <= 0) return false;
+        tampon.append(bloc, r);
+    }
+    ligne = tampon.substr(0, fin);
+    tampon.erase(0, fin + 1);
+    if (!ligne.empty() && ligne[ligne.size() - 1] == '\r') ligne.erase(ligne.size() - 1);
+    return true;
+}
+
+/* Arrête le serveur : réveille accept(), coupe les clients et annule leurs résolutions */
+void arreter_serveur(EtatServeur& etat) {
+    lock_guard<mutex> verrou(etat.verrou);
+    etat.arret = true;
+    shutdown(etat.serveur, SHUT_RDWR);
+    for (int client : etat.clients) shutdown(client, SHUT_RDWR);
+}
+
+/* Traite une requête ; retourne false pour fermer la connexion */
+bool traiter_requete(int client, const string& ligne, EtatServeur& etat) {
+    istringstream iss(ligne);
+    string commande, id;
+    iss >> commande;
+
+    if (commande == "QUITTER") return false;
+    if (commande == "ARRET") {
+        envoyer_ligne(client, "OK");
+        arreter_serveur(etat);
+        return false;
+    }
+    if (commande == "LISTE") {
+        vector<string> lignes;
+        {
+            lock_guard<mutex> verrou(etat.verrou);
+            for (map<string, InstanceServeur>::iterator it = etat.instances.begin(); it != etat.instances.end(); ++it) {
+                InstanceServeur& inst = it->second;
+                ostringstream oss;
+                oss << "INSTANCE " << it->first;
+                if (inst.verrou.try_lock()) {  // Pas d'attente derrière une résolution
+                    oss << " " << inst.n << " sommets, meilleur score "
+                        << (inst.elite.empty() ? -1 : inst.elite[0].score);
+                    inst.verrou.unlock();
+                } else {
+                    oss << " occupee";
+                }
+                lignes.push_back(oss.str());
+            }
+        }
+        for (const string& l : lignes) envoyer_ligne(client, l);
+        return envoyer_ligne(client, "OK");
+    }
+
+    if (!(iss >> id)) return envoyer_ligne(client, "ERREUR identifiant d'instance manquant");
+
+    if (commande == "CHARGER") {
+        // Graphe lu à part : un fichier illisible laisse l'instance existante intacte
+        string fichier, erreur;
+        int n = 0;
+        CompressedAdjacency graphe;
+        if (!(iss >> fichier)) return envoyer_ligne(client, "ERREUR fichier de graphe manquant");
+        if (!charger_graphe(fichier, n, graphe, erreur)) {
+            return envoyer_ligne(client, "ERREUR graphe illisible: " + erreur);
+        }
+        InstanceServeur& inst = *trouver_instance(etat, id, true);
+        lock_guard<mutex> verrou(inst.verrou);
+        inst.n = n;
+        inst.voisins = move(graphe);
+        inst.elite.clear();
+        return envoyer_ligne(client, "OK " + to_string(inst.n) + " sommets");
+    }
+
+    InstanceServeur* trouvee = trouver_instance(etat, id, false);
+    if (!trouvee) return envoyer_ligne(client, "ERREUR instance inconnue: " + id);
+    InstanceServeur& inst = *trouvee;
+    lock_guard<mutex> verrou(inst.verrou);
+
+    if (commande == "DELTA") {
+        string fichier;
+        iss >> fichier;
+        vector<int> touches;
+        int n_ajouts, n_suppressions;
+        echanger_graphe(inst);
+        bool ok = appliquer_delta(fichier, touches, n_ajouts, n_suppressions);
+        if (ok) {
+            vector<Solution> elite;
+            for (const Solution& e : inst.elite) inserer_elite(elite, reparer_solution(e, touches), taille_elite_serveur);
+            inst.elite.swap(elite);
+        }
+        echanger_graphe(inst);
+        if (!ok) return envoyer_ligne(client, "ERREUR delta illisible: " + fichier);
+        return envoyer_ligne(client, "OK " + to_string(n_ajouts) + " ajouts " +
+                             to_string(n_suppressions) + " suppressions");
+    }
+
+    if (commande == "RESOUDRE") {
+        double temps;
+        if (!(iss >> temps)) return envoyer_ligne(client, "ERREUR budget manquant");
+
+        // Surcharges des paramètres, rétablies après la requête
+        double alpha_0 = alpha, beta_0 = param_beta, ti_0 = temps_intensification_limit;
+        double td_0 = temps_diversification_limit;
+        int k_0 = k;
+        uint64_t graine = chrono::system_clock::now().time_since_epoch().count();
+        Solution depart;
+        bool depart_donne = false;
+
+        string option;
+        while (iss >> option) {
+            size_t egal = option.find('=');
+            string cle = option.substr(0, egal);
+            string valeur = egal == string::npos ? "" : option.substr(egal + 1);
+            if (cle == "seed") graine = strtoull(valeur.c_str(), NULL, 10);
+            else if (cle == "a") alpha = atof(valeur.c_str());
+            else if (cle == "b") param_beta = atof(valeur.c_str());
+            else if (cle == "k") k = atoi(valeur.c_str());
+            else if (cle == "ti") temps_intensification_limit = atof(valeur.c_str());
+            else if (cle == "td") temps_diversification_limit = atof(valeur.c_str());
+            else if (cle == "depart") {
+                replace(valeur.begin(), valeur.end(), ',', ' ');
+                istringstream sommets(valeur);
+                int v;
+                while (sommets >> v) {
+                    if (v >= 0 && v < inst.n) depart.vertices.insert(v);
+                }
+                depart.score = depart.vertices.size();
+                depart_donne = true;
+            }
+        }
+
+        echanger_graphe(inst);
+        flux_racine = FluxAleatoire(graine);
+
+        // Départ : solution fournie si elle est réalisable, sinon la meilleure de l'élite
+        const Solution* solution_depart = NULL;
+        if (depart_donne) {
+            if (solution_realisable(depart)) solution_depart = &depart;
+            else envoyer_ligne(client, "INFO solution de depart non realisable, ignoree");
+        }
+        if (!solution_depart && !inst.elite.empty()) solution_depart = &inst.elite[0];
+
+        bool connecte = true;
+        rappel_amelioration = [&](const Solution& sol) {
+            if (connecte) connecte = envoyer_ligne(client, "AMELIORATION " + solution_en_ligne(sol));
+        };
+        LogFile log_requete;  // Non ouvert : les améliorations partent sur la socket
+        Solution resultat = algorithme_local_branching(log_requete, temps, NULL, solution_depart);
+        rappel_amelioration = nullptr;
+        echanger_graphe(inst);
+
+        inserer_elite(inst.elite, resultat, taille_elite_serveur);
+        alpha = alpha_0;
+        param_beta = beta_0;
+        k = k_0;
+        temps_intensification_limit = ti_0;
+        temps_diversification_limit = td_0;
+
+        return connecte && envoyer_ligne(client, "FIN " + solution_en_ligne(resultat));
+    }
+
+    return envoyer_ligne(client, "ERREUR commande inconnue: " + commande);
+}
+
+/* Thread d'un client : ses requêtes jusqu'à QUITTER, la déconnexion ou ARRET */
+void servir_client(EtatServeur& etat, int client, int numero) {
+    installer_parametres(etat.parametres);
+    prefixe_fichiers_cplex = "srv" + to_string(numero) + "_";
+    jeton_annulation = &etat.arret;
+
+    string tampon, ligne;
+    while (!etat.arret && recevoir_ligne(client, tampon, ligne)) {
+        if (ligne.empty()) continue;
+        if (!traiter_requete(client, ligne, etat)) break;
+    }
+
+    // Dernier accès à etat : servir() n'en sort qu'une fois n_clients à zéro
+    lock_guard<mutex> verrou(etat.verrou);
+    etat.clients.erase(client);
+    close(client);
+    etat.n_clients--;
+    etat.fin_client.notify_all();
+}
+
+int servir(const string& chemin_socket) {
+    int serveur = socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un adresse;
+    memset(&adresse, 0, sizeof(adresse));
+    adresse.sun_family = AF_UNIX;
+    if (serveur < 0 || chemin_socket.size() >= sizeof(adresse.sun_path)) {
+        JOURNAL_ERREUR << "Erreur: socket impossible a creer: " << chemin_socket;
+        return 1;
+    }
+    strcpy(adresse.sun_path, chemin_socket.c_str());
+
+    // Une socket qui répond appartient à un serveur vivant : ne pas la voler
+    int sonde = socket(AF_UNIX, SOCK_STREAM, 0);
+    bool occupee = sonde >= 0 && connect(sonde, (sockaddr*)&adresse, sizeof(adresse)) == 0;
+    if (sonde >= 0) close(sonde);
+    if (occupee) {
+        JOURNAL_ERREUR << "Erreur: un serveur repond deja sur " << chemin_socket;
+        close(serveur);
+        return 1;
+    }
+    unlink(chemin_socket.c_str());  // Socket laissée par un serveur arrêté
+    if (bind(serveur, (sockaddr*)&adresse, sizeof(adresse)) < 0 || listen(serveur, 8) < 0) {
+        JOURNAL_ERREUR << "Erreur: impossible d'ecouter sur " << chemin_socket;
+        close(serveur);
+        return 1;
+    }
+    JOURNAL_CONSOLE << "Serveur lb_pids a l'ecoute sur " << chemin_socket;
+
+    EtatServeur etat;
+    etat.serveur = serveur;
+    etat.parametres = capturer_parametres();
+    int numero = 0;
+    while (!etat.arret) {
+        int client = accept(serveur, NULL, NULL);
+        if (client < 0) continue;
+
+        lock_guard<mutex> verrou(etat.verrou);
+        if (etat.arret) {
+            close(client);
+            break;
+        }
+        etat.clients.insert(client);
+        etat.n_clients++;
+        thread(servir_client, ref(etat), client, numero++).detach();
+    }
+
+    unique_lock<mutex> verrou(etat.verrou);
+    etat.fin_client.wait(verrou, [&]() { return etat.n_clients == 0; });
+    close(serveur);
+    unlink(chemin_socket.c_str());
+    return 0;
+}
+
+#endif
+
+
+
+
+// ====================================================
+// RECHERCHE COOPÉRATIVE MULTI-PROCESSUS (-coop)
+// ====================================================
+
+#ifndef _WIN32
 
+/*
+ * Plusieurs processus lb_pids sur la même instance partagent leur meilleure
+ * solution : chacun publie ses améliorations et, au début de chaque itération,
+ * adopte la solution commune si elle est meilleure que la sienne.
+ *
+ * -coop <nom> : segment POSIX /<nom> (shm_open), ou fichier projeté en mémoire si
+ * le nom contient un '/'. Le segment contient une seule case protégée par un
+ * seqlock : l'écrivain passe la séquence à une valeur impaire par CAS (ce qui exclut
+ * aussi les autres écrivains), écrit le score et les bits de la solution, puis la
+ * repasse à une valeur paire ; le lecteur recommence si la séquence était impaire ou
+ * a changé pendant sa copie. Tant que le score commun n'est pas meilleur, une
+ * lecture coûte un chargement atomique. Chaque processus garde un verrou partagé
+ * (flock) sur le segment ; celui qui obtient le verrou exclusif en se détachant est
+ * le dernier et retire le segment.
+ *
+ * Repli si le segment ne peut pas être créé (ou -coop socket:<nom>) : socket Unix
+ * <PIDS_TMPDIR ou /tmp>/lb_pids_<nom>.sock. Le processus qui obtient le verrou
+ * <socket>.verrou (flock) tient la case et répond aux autres, une requête par
+ * connexion, au plus toutes les -coop_periode secondes par processus :
+ *   PUBLIER <empreinte> <score> <hex>   ->  OK
+ *   LIRE <empreinte> <score>            ->  MEILLEURE <score> <hex> | RIEN
+ * Il recopie la case dans <socket>.solution à chaque amélioration. S'il s'arrête, le
+ * premier processus qui reprend le verrou tient la case à sa place et la recharge
+ * depuis ce fichier. Les membres gardent un verrou partagé sur <socket>.membres :
+ * le dernier à se détacher retire les fichiers.
+ *
+ * Les solutions circulent avec les identifiants d'origine (indépendants de -ordre).
+ * L'empreinte du graphe et des seuils empêche de mélanger deux instances.
+ */
 
+const uint64_t magique_coop = 0x504f4f4353444950ULL;  // "PIDSCOOP"
+
+struct EnTeteCoop {
+    atomic<uint64_t> magique;       // Écrit en dernier par le créateur du segment
+    uint64_t empreinte;
+    int32_t n;
+    int32_t mots;
+    atomic<uint64_t> sequence;      // Impaire pendant une écriture
+    atomic<int32_t> score;
+    atomic<int32_t> auteur;         // pid du dernier écrivain
+    atomic<uint64_t> publications;
+    // Suivi de mots atomic<uint64_t> : la solution en bits
+};
+static_assert(atomic<uint64_t>::is_always_lock_free && atomic<int32_t>::is_always_lock_free,
+              "les atomiques du segment doivent etre sans verrou pour etre partages entre processus");
+
+enum ModeCoop { COOP_AUCUN = 0, COOP_MEMOIRE, COOP_SOCKET };
+
+// Un seul état par processus, utilisé par le thread principal (et le thread de service de la case)
+struct EtatCoop {
+    int mode = COOP_AUCUN;
+    uint64_t empreinte = 0;
+    int n = 0;
+    vector<int> ordre, inverse;     // Interne -> origine et origine -> interne ; vides : identité
+    long long publiees = 0, adoptees = 0;
+
+    // Segment partagé
+    EnTeteCoop* entete = NULL;
+    atomic<uint64_t>* bits = NULL;
+    size_t taille = 0;
+    string segment;                 // Nom POSIX ou chemin du fichier projeté
+    bool fichier = false;
+
+    int membre = -1;                // Verrou partagé : segment, ou <socket>.membres
+
+    // Socket : case tenue par ce processus si verrou >= 0
+    string chemin;
+    int verrou = -1;
+    int serveur = -1;
+    thread service;
+    atomic<bool> arret{false};
+    mutex mutex_case;
+    Solution meilleure;             // Case locale, identifiants d'origine
+    chrono::steady_clock::time_point derniere_lecture;
+};
+EtatCoop coop;
 
-/* Algorithme principal de Local Branching */
+thread_local double periode_coop = 1.0;  // Secondes entre deux lectures de la case par socket
 
+/* Empreinte du graphe et des seuils, indépendante de la numérotation (ordre : interne -> origine) */
+uint64_t empreinte_graphe(const vector<int>& ordre) {
+    uint64_t h = FluxAleatoire(n_sommets)();
+    for (int i = 0; i < n_sommets; ++i) {
+        uint64_t a = ordre.empty() ? i : ordre[i];
+        h += FluxAleatoire(~((a << 32) | (uint32_t)seuils[i]))();
+        for (int v : voisins[i]) {
+            uint64_t b = ordre.empty() ? v : ordre[v];
+            if (a < b) h += FluxAleatoire((a << 32) | b)();
+        }
+    }
+    return h;
+}
 
+/*
+ * Attache le segment partagé (créé et initialisé par le premier processus).
+ * false : segment indisponible (repli sur la socket), ou d'une autre instance si
+ * erreur est renseignée.
+ */
+bool attacher_segment_coop(const string& nom, string& erreur) {
+    int mots = (coop.n + 63) / 64;
+    size_t taille = sizeof(EnTeteCoop) + mots * sizeof(uint64_t);
+    bool fichier = nom.find('/') != string::npos;
+    string chemin = fichier ? nom : "/" + nom;
+
+    // Verrou partagé posé avant tout accès ; un segment retiré entre-temps par le dernier
+    // processus (nlink 0) est recréé
+    int fd = -1;
+    bool createur = false;
+    for (int essai = 0; essai < 100 && fd < 0; ++essai) {
+        fd = fichier ? open(chemin.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600)
+                     : shm_open(chemin.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        createur = fd >= 0;
+        if (!createur) {
+            if (errno != EEXIST) return false;
+            fd = fichier ? open(chemin.c_str(), O_RDWR) : shm_open(chemin.c_str(), O_RDWR, 0600);
+            if (fd < 0 && errno != ENOENT) return false;
+            if (fd < 0) continue;
+        }
+        struct stat st;
+        if (flock(fd, LOCK_SH) != 0 || fstat(fd, &st) != 0) {
+            close(fd);
+            return false;
+        }
+        if (st.st_nlink == 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+    if (fd < 0) return false;
 
-/* Algorithme principal de Local Branching */
-/* Algorithme principal de Local Branching */
-Solution algorithme_local_branching(ofstream& logFile) {
+    if (createur) {
+        if (ftruncate(fd, taille) != 0) {
+            close(fd);
+            if (fichier) unlink(chemin.c_str());
+            else shm_unlink(chemin.c_str());
+            return false;
+        }
+    } else {
+        // Le créateur peut ne pas avoir encore dimensionné le segment
+        struct stat st;
+        st.st_size = 0;
+        for (int essai = 0; essai < 1000 && (fstat(fd, &st) != 0 || st.st_size == 0); ++essai) {
+            this_thread::sleep_for(chrono::milliseconds(1));
+        }
+        if ((size_t)st.st_size != taille) {
+            close(fd);
+            erreur = "le segment " + chemin + " appartient a une autre instance";
+            return false;
+        }
+    }
 
-    unsigned seed = chrono::system_clock::now().time_since_epoch().count();
-    default_random_engine generator(seed);
-    uniform_real_distribution<double> distribution(0.0, 1.0);
+    void* p = mmap(NULL, taille, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (p == MAP_FAILED) {
+        close(fd);
+        return false;
+    }
+    EnTeteCoop* e = (EnTeteCoop*)p;
+
+    if (createur) {
+        // ftruncate a mis le segment à zéro : séquence 0, solution vide
+        e->empreinte = coop.empreinte;
+        e->n = coop.n;
+        e->mots = mots;
+        e->score.store(numeric_limits<int32_t>::max(), memory_order_relaxed);
+        e->magique.store(magique_coop, memory_order_release);
+    } else {
+        for (int essai = 0; essai < 1000 && e->magique.load(memory_order_acquire) != magique_coop; ++essai) {
+            this_thread::sleep_for(chrono::milliseconds(1));
+        }
+        if (e->magique.load(memory_order_acquire) != magique_coop ||
+            e->empreinte != coop.empreinte || e->n != coop.n) {
+            munmap(p, taille);
+            close(fd);
+            erreur = "le segment " + chemin + " appartient a une autre instance";
+            return false;
+        }
+    }
 
-    clock_t debut_total = clock();
+    coop.entete = e;
+    coop.bits = (atomic<uint64_t>*)((char*)p + sizeof(EnTeteCoop));
+    coop.taille = taille;
+    coop.segment = chemin;
+    coop.fichier = fichier;
+    coop.membre = fd;
+    return true;
+}
 
-    // Appel correct de l'heuristique
-    Solution x0 = heuristique_roulette_exacte(n_sommets, voisins, generator, distribution);
-    Solution x_bar = x0;
+void publier_segment_coop(const Solution& sol) {
+    EnTeteCoop* e = coop.entete;
+    if (sol.score >= e->score.load(memory_order_relaxed)) return;
 
-    cout << "Solution initiale: score = " << x0.score << endl;
-    if (logFile.is_open()) logFile << "Solution initiale: score = " << x0.score << endl;
+    vector<uint64_t> mots(e->mots, 0);
+    for (int v : sol.vertices) mots[v >> 6] |= 1ULL << (v & 63);
 
+    // Prise de la case : séquence paire -> impaire
+    uint64_t s = e->sequence.load(memory_order_relaxed);
+    chrono::steady_clock::time_point debut = chrono::steady_clock::now();
     while (true) {
-        clock_t maintenant = clock();
-        double temps_ecoule = double(maintenant - debut_total) / CLOCKS_PER_SEC;
+        if (s & 1) {
+            // Écrivain mort pendant l'écriture : au bout de 100 ms la case est libérée de force
+            // (un lecteur vérifie toujours la solution lue)
+            if (secondes_depuis(debut) > 0.1) {
+                e->sequence.compare_exchange_strong(s, s + 1, memory_order_relaxed);
+                debut = chrono::steady_clock::now();
+            } else {
+                this_thread::yield();
+            }
+            s = e->sequence.load(memory_order_relaxed);
+            continue;
+        }
+        if (e->sequence.compare_exchange_weak(s, s + 1, memory_order_acquire, memory_order_relaxed)) break;
+    }
+    atomic_thread_fence(memory_order_release);
+
+    if (sol.score < e->score.load(memory_order_relaxed)) {
+        for (int m = 0; m < e->mots; ++m) coop.bits[m].store(mots[m], memory_order_relaxed);
+        e->score.store(sol.score, memory_order_relaxed);
+        e->auteur.store(getpid(), memory_order_relaxed);
+        e->publications.fetch_add(1, memory_order_relaxed);
+        coop.publiees++;
+    }
+    e->sequence.store(s + 2, memory_order_release);
+}
 
-        if (temps_ecoule >= temps_total_limit) {
-            break;
+/* Copie cohérente de la case si son score est meilleur que score_local */
+bool lire_segment_coop(int score_local, Solution& sol) {
+    EnTeteCoop* e = coop.entete;
+    if (e->score.load(memory_order_relaxed) >= score_local) return false;
+
+    vector<uint64_t> copie(e->mots);
+    for (int essai = 0; essai < 1000; ++essai) {
+        uint64_t s1 = e->sequence.load(memory_order_acquire);
+        if (s1 & 1) {
+            this_thread::yield();
+            continue;
+        }
+        int score = e->score.load(memory_order_relaxed);
+        for (int m = 0; m < e->mots; ++m) copie[m] = coop.bits[m].load(memory_order_relaxed);
+        atomic_thread_fence(memory_order_acquire);
+        if (e->sequence.load(memory_order_relaxed) != s1) continue;
+
+        if (score >= score_local) return false;
+        sol = Solution();
+        for (int m = 0; m < e->mots; ++m) {
+            for (uint64_t w = copie[m]; w; w &= w - 1) sol.vertices.insert(m * 64 + __builtin_ctzll(w));
         }
+        sol.score = sol.vertices.size();
+        return sol.score == score;
+    }
+    return false;
+}
 
-        // CORRECTION : utiliser la bonne fonction d'intensification
-        Solution x_intensif = phase_intensification_avec_run_cplex(x_bar, temps_intensification_limit);
+/* Recopie de la case (mutex_case tenu) : le processus qui la reprend repart de cette solution */
+void sauver_case_coop() {
+    string fichier = coop.chemin + ".solution";
+    string temporaire = fichier + ".tmp";
+    ofstream out(temporaire.c_str());
+    if (!out.is_open()) return;
+    out << coop.empreinte << " " << coop.meilleure.score << " " << solution_vers_hex(coop.meilleure, coop.n) << endl;
+    out.close();
+    if (out.fail() || rename(temporaire.c_str(), fichier.c_str()) != 0) unlink(temporaire.c_str());
+}
 
-        int dist = distance_hamming(x_bar, x_intensif);
+/* Case laissée par le processus précédent, si elle est de la même instance */
+void charger_case_coop() {
+    ifstream in((coop.chemin + ".solution").c_str());
+    uint64_t empreinte;
+    int score;
+    string hex;
+    if (!(in >> empreinte >> score >> hex) || empreinte != coop.empreinte) return;
+    Solution sol = hex_vers_solution(hex, coop.n);
+    lock_guard<mutex> verrou(coop.mutex_case);
+    if (sol.score == score && sol.score < coop.meilleure.score) coop.meilleure = sol;
+}
 
-        if (x_intensif.score < x_bar.score) {
-            cout << "Amelioration trouvee: " << x_intensif.score
-                 << " (distance Hamming: " << dist << ")" << endl;
-            if (logFile.is_open()) logFile << "Amelioration trouvee: " << x_intensif.score
-                 << " (distance Hamming: " << dist << ")" << endl;
+/* Réponse de la case tenue par ce processus (thread de service ou appel direct) */
+string reponse_case_coop(const string& requete) {
+    istringstream iss(requete);
+    string commande, hex;
+    uint64_t empreinte;
+    int score;
+    iss >> commande >> empreinte >> score;
+    if (iss.fail() || empreinte != coop.empreinte) return "ERREUR instance differente";
+
+    lock_guard<mutex> verrou(coop.mutex_case);
+    if (commande == "PUBLIER" && (iss >> hex)) {
+        Solution sol = hex_vers_solution(hex, coop.n);
+        if (sol.score == score && sol.score < coop.meilleure.score) {
+            coop.meilleure = sol;
+            sauver_case_coop();
+        }
+        return "OK";
+    }
+    if (commande == "LIRE") {
+        if (coop.meilleure.score >= score) return "RIEN";
+        return "MEILLEURE " + to_string(coop.meilleure.score) + " " + solution_vers_hex(coop.meilleure, coop.n);
+    }
+    return "ERREUR commande inconnue";
+}
 
-            if (dist <= k) {
-                x_bar = x_intensif;
-            } else {
-                vector<int> age_local(n_sommets, -1);
-                for (int v : x_intensif.vertices) {
-                    age_local[v] = 0;
-                }
+void servir_case_coop() {
+    while (!coop.arret.load()) {
+        int client = accept(coop.serveur, NULL, NULL);
+        if (client < 0) continue;
+        timeval delai = { 1, 0 };  // Un client bloqué ne retient pas les autres
+        setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &delai, sizeof(delai));
+        string tampon, ligne;
+        if (recevoir_ligne(client, tampon, ligne)) envoyer_ligne(client, reponse_case_coop(ligne));
+        close(client);
+    }
+}
 
-                double temps_restant = temps_total_limit - temps_ecoule;
-                if (temps_restant > 10.0) temps_restant = 10.0;
+/* Devient le processus qui tient la case si personne ne détient le verrou */
+bool prendre_case_coop() {
+    if (coop.verrou >= 0) return true;
+    int fd = open((coop.chemin + ".verrou").c_str(), O_RDWR | O_CREAT, 0600);
+    if (fd < 0) return false;
+    if (flock(fd, LOCK_EX | LOCK_NB) != 0) {
+        close(fd);
+        return false;
+    }
 
-                Solution x_cplex;
-                // CORRECTION : utiliser run_cplex au lieu de executer_cplex
-                run_cplex(x_cplex, x_bar, age_local, temps_restant);
+    sockaddr_un adresse;
+    memset(&adresse, 0, sizeof(adresse));
+    adresse.sun_family = AF_UNIX;
+    strcpy(adresse.sun_path, coop.chemin.c_str());
+    unlink(coop.chemin.c_str());  // Socket laissée par un processus arrêté
+    int serveur = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (serveur < 0 || bind(serveur, (sockaddr*)&adresse, sizeof(adresse)) < 0 || listen(serveur, 16) < 0) {
+        if (serveur >= 0) close(serveur);
+        close(fd);
+        return false;
+    }
+    coop.verrou = fd;
+    coop.serveur = serveur;
+    charger_case_coop();
+    coop.service = thread(servir_case_coop);
+    return true;
+}
 
-                // Note: run_cplex renvoie déjà une solution complète, pas besoin de fusionner
-                // x_cplex.vertices.insert(x_bar.vertices.begin(), x_bar.vertices.end());
-                x_cplex.score = calculer_score(x_cplex);
+/* Envoie une requête à la case, locale ou tenue par un autre processus ; "" si personne ne répond */
+string echanger_case_coop(const string& requete) {
+    if (coop.verrou >= 0) return reponse_case_coop(requete);
+
+    sockaddr_un adresse;
+    memset(&adresse, 0, sizeof(adresse));
+    adresse.sun_family = AF_UNIX;
+    strcpy(adresse.sun_path, coop.chemin.c_str());
+    int client = socket(AF_UNIX, SOCK_STREAM, 0);
+    string reponse;
+    if (client >= 0 && connect(client, (sockaddr*)&adresse, sizeof(adresse)) == 0) {
+        timeval delai = { 1, 0 };
+        setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &delai, sizeof(delai));
+        string tampon;
+        if (!envoyer_ligne(client, requete) || !recevoir_ligne(client, tampon, reponse)) reponse = "";
+    }
+    if (client >= 0) close(client);
 
-                if (x_cplex.score < x_bar.score) {
-                    x_bar = x_cplex;
-                    cout << "Nouvelle meilleure solution apres CPLEX: " << x_bar.score << endl;
-                    if (logFile.is_open()) logFile << "Nouvelle meilleure solution apres CPLEX: " << x_bar.score << endl;
-                }
-            }
-        } else {
-            // CORRECTION : utiliser la bonne fonction de diversification
-            Solution x_diversif = phase_diversification_avec_roulette(x_bar, temps_diversification_limit,
-                                                                     generator, distribution);
-
-            if (x_diversif.score < x_bar.score) {
-                x_bar = x_diversif;
-                cout << "Diversification reussie: " << x_bar.score << endl;
-                if (logFile.is_open()) logFile << "Diversification reussie: " << x_bar.score << endl;
+    // Le processus qui tenait la case s'est arrêté : on la reprend
+    if (reponse.empty() && prendre_case_coop()) {
+        JOURNAL_CONSOLE << "Cooperation: case reprise (score " << coop.meilleure.score << ")";
+        return reponse_case_coop(requete);
+    }
+    return reponse;
+}
+
+/* Quitte la coopération (idempotent, aussi appelé par atexit) ; le dernier membre retire le segment ou les fichiers */
+void detacher_coop() {
+    if (coop.entete) munmap(coop.entete, coop.taille);
+    if (coop.service.joinable()) {
+        coop.arret = true;
+        shutdown(coop.serveur, SHUT_RDWR);  // Réveille accept()
+        coop.service.join();
+    }
+    if (coop.serveur >= 0) {
+        close(coop.serveur);
+        unlink(coop.chemin.c_str());
+    }
+    if (coop.verrou >= 0) close(coop.verrou);  // Libère le verrou après la socket : un autre processus reprend la case
+    if (coop.membre >= 0) {
+        if (flock(coop.membre, LOCK_EX | LOCK_NB) == 0) {
+            if (coop.entete) {
+                if (coop.fichier) unlink(coop.segment.c_str());
+                else shm_unlink(coop.segment.c_str());
+            } else {
+                unlink((coop.chemin + ".verrou").c_str());
+                unlink((coop.chemin + ".solution").c_str());
+                unlink((coop.chemin + ".membres").c_str());
             }
         }
+        close(coop.membre);
+    }
+    coop.entete = NULL;
+    coop.serveur = coop.verrou = coop.membre = -1;
+    coop.mode = COOP_AUCUN;
+}
+
+/*
+ * Rejoint la coopération nom avec le graphe du thread (ordre : interne -> origine,
+ * vide si pas de renumérotation). false si le segment est celui d'une autre instance.
+ */
+bool attacher_coop(const string& nom, const vector<int>& ordre, string& erreur) {
+    // exit() pendant la recherche : le thread de service est arrêté avant la destruction de coop
+    static bool detachement_installe = false;
+    if (!detachement_installe) {
+        atexit(detacher_coop);
+        detachement_installe = true;
+    }
 
-        maintenant = clock();
-        temps_ecoule = double(maintenant - debut_total) / CLOCKS_PER_SEC;
+    coop.n = n_sommets;
+    coop.empreinte = empreinte_graphe(ordre);
+    coop.ordre = ordre;
+    coop.inverse = ordre.empty() ? vector<int>() : inverser_ordre(ordre);
+    coop.meilleure.score = numeric_limits<int>::max();
 
-        if (temps_ecoule >= temps_total_limit) {
-            break;
-        }
+    bool par_socket = nom.compare(0, 7, "socket:") == 0;
+    string base = par_socket ? nom.substr(7) : nom;
+    if (!par_socket && attacher_segment_coop(base, erreur)) {
+        coop.mode = COOP_MEMOIRE;
+        return true;
     }
+    if (!erreur.empty()) return false;
 
-    return x_bar;
+    replace(base.begin(), base.end(), '/', '_');
+    const char* dir = getenv("PIDS_TMPDIR");
+    coop.chemin = string(dir && dir[0] ? dir : "/tmp") + "/lb_pids_" + base + ".sock";
+    if (coop.chemin.size() >= sizeof(sockaddr_un().sun_path)) {
+        erreur = "chemin de socket trop long: " + coop.chemin;
+        return false;
+    }
+    // Membre avant de prendre la case ; fichier retiré entre-temps par le dernier processus : recréé
+    for (int essai = 0; essai < 100 && coop.membre < 0; ++essai) {
+        int fd = open((coop.chemin + ".membres").c_str(), O_RDWR | O_CREAT, 0600);
+        struct stat st;
+        if (fd < 0 || flock(fd, LOCK_SH) != 0 || fstat(fd, &st) != 0) {
+            if (fd >= 0) close(fd);
+            erreur = "verrou impossible a poser: " + coop.chemin + ".membres";
+            return false;
+        }
+        if (st.st_nlink > 0) coop.membre = fd;
+        else close(fd);
+    }
+    coop.mode = COOP_SOCKET;
+    prendre_case_coop();
+    return true;
 }
 
+/* Publie une amélioration (identifiants internes) */
+void publier_solution_coop(const Solution& sol) {
+    Solution origine = coop.ordre.empty() ? sol : renumeroter_solution(sol, coop.ordre);
+    if (coop.mode == COOP_MEMOIRE) {
+        publier_segment_coop(origine);
+    } else if (echanger_case_coop("PUBLIER " + to_string(coop.empreinte) + " " + to_string(origine.score) +
+                                  " " + solution_vers_hex(origine, coop.n)) == "OK") {
+        coop.publiees++;
+    }
+}
 
+/* Solution commune (identifiants internes) si elle est meilleure que score_local */
+bool adopter_solution_coop(int score_local, Solution& sol) {
+    Solution origine;
+    if (coop.mode == COOP_MEMOIRE) {
+        if (!lire_segment_coop(score_local, origine)) return false;
+    } else {
+        if (secondes_depuis(coop.derniere_lecture) < periode_coop) return false;
+        coop.derniere_lecture = chrono::steady_clock::now();
+        istringstream iss(echanger_case_coop("LIRE " + to_string(coop.empreinte) + " " + to_string(score_local)));
+        string mot, hex;
+        int score;
+        if (!(iss >> mot >> score >> hex) || mot != "MEILLEURE") return false;
+        origine = hex_vers_solution(hex, coop.n);
+        if (origine.score != score) return false;
+    }
+    if (origine.score >= score_local) return false;
+    sol = coop.inverse.empty() ? origine : renumeroter_solution(origine, coop.inverse);
+    coop.adoptees++;
+    return true;
+}
 
-
+#endif
 
 
 
@@ -1238,6 +5134,7 @@ Solution algorithme_local_branching(ofstream& logFile) {
 
 
 /* Fonction principale */
+#ifndef LIBPIDS
 int main(int argc, char** argv) {
 
     // Vérifier le nombre d'arguments
@@ -1248,6 +5145,15 @@ int main(int argc, char** argv) {
 
     string option_mode = "";
     string fichier_entree = "";
+    string fichier_reprise = "";
+    string fichier_delta = "";
+    string fichier_precedente = "";
+    string fichier_graphe_mis_a_jour = "";
+    bool temps_total_donne = false;
+    string socket_serveur = "";
+    string fichier_seuils = "";
+    int repetitions_banc = 0;
+    string nom_coop = "";
 
     // Parse arguments
     for (int i = 1; i < argc; i++) {
@@ -1261,6 +5167,7 @@ int main(int argc, char** argv) {
         }
         else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
             temps_total_limit = atof(argv[++i]);
+            temps_total_donne = true;
         }
         else if (strcmp(argv[i], "-ti") == 0 && i + 1 < argc) {
             temps_intensification_limit = atof(argv[++i]);
@@ -1277,31 +5184,211 @@ int main(int argc, char** argv) {
         else if (strcmp(argv[i], "-k") == 0 && i + 1 < argc) {
             k = atoi(argv[++i]);
         }
+        else if (strcmp(argv[i], "-gap") == 0 && i + 1 < argc) {
+            gap_cible = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-pb") == 0 && i + 1 < argc) {
+            periode_bornes = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-borne_lp") == 0) {
+            borne_lp_cplex = true;
+        }
+        else if (strcmp(argv[i], "-abort") == 0) {
+            cplex_abort = true;
+        }
+        else if (strcmp(argv[i], "-he") == 0) {
+            heuristic_emphasis = true;
+        }
+        else if (strcmp(argv[i], "-nocutoff") == 0) {
+            cutoff_incumbent = false;
+        }
+        else if (strcmp(argv[i], "-ei") == 0 && i + 1 < argc) {
+            emphase_intensification = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-er") == 0 && i + 1 < argc) {
+            emphase_reparation = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-ee") == 0 && i + 1 < argc) {
+            emphase_exacte = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-lbc") == 0 && i + 1 < argc) {
+            string mode = argv[++i];
+            if (mode == "aucune") mode_contrainte_lb = LB_AUCUNE;
+            else if (mode == "avec") mode_contrainte_lb = LB_AVEC_FIXATION;
+            else if (mode == "seule") mode_contrainte_lb = LB_SEULE;
+            else {
+                JOURNAL_ERREUR << "Erreur: mode -lbc inconnu (aucune, avec, seule)";
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "-voisinage") == 0 && i + 1 < argc) {
+            string nom = argv[++i];
+            generateur_voisinage = -1;
+            for (int g = 0; g < N_VOISINAGES; ++g) {
+                if (nom == noms_voisinage[g]) generateur_voisinage = g;
+            }
+            if (generateur_voisinage < 0) {
+                JOURNAL_ERREUR << "Erreur: voisinage inconnu (aleatoire, bfs, partition, redondance)";
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "-bits") == 0 && i + 1 < argc) {
+            string mode = argv[++i];
+            char* fin;
+            double seuil = strtod(mode.c_str(), &fin);
+            if (mode == "auto") mode_bits = BITS_AUTO;
+            else if (mode == "oui") mode_bits = BITS_OUI;
+            else if (mode == "non") mode_bits = BITS_NON;
+            else if (!mode.empty() && *fin == '\0' && seuil >= 0.0 && seuil <= 1.0) {  // .1, 5e-2, ...
+                mode_bits = BITS_AUTO;
+                densite_bits = seuil;
+            } else {
+                JOURNAL_ERREUR << "Erreur: -bits attend auto, oui, non ou un seuil de densite entre 0 et 1";
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "-ordre") == 0 && i + 1 < argc) {
+            string nom = argv[++i];
+            ordre_renumerotation = -1;
+            for (int o = 0; o < N_ORDRES; ++o) {
+                if (nom == noms_ordre[o]) ordre_renumerotation = o;
+            }
+            if (ordre_renumerotation < 0) {
+                JOURNAL_ERREUR << "Erreur: ordre inconnu (aucun, rcm, degre, bfs)";
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "-bench_ordre") == 0 && i + 1 < argc) {
+            repetitions_banc = max(1, atoi(argv[++i]));
+        }
+        else if (strcmp(argv[i], "-rho") == 0 && i + 1 < argc) {
+            rho = atof(argv[++i]);
+            if (rho <= 0.0 || rho > 1.0) {
+                JOURNAL_ERREUR << "Erreur: -rho attend une valeur dans ]0, 1]";
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "-seuils") == 0 && i + 1 < argc) {
+            fichier_seuils = argv[++i];
+        }
+        else if (strcmp(argv[i], "-serve") == 0 && i + 1 < argc) {
+            socket_serveur = argv[++i];
+        }
+        else if (strcmp(argv[i], "-delta") == 0 && i + 1 < argc) {
+            fichier_delta = argv[++i];
+        }
+        else if (strcmp(argv[i], "-precedente") == 0 && i + 1 < argc) {
+            fichier_precedente = argv[++i];
+        }
+        else if (strcmp(argv[i], "-graphe_maj") == 0 && i + 1 < argc) {
+            fichier_graphe_mis_a_jour = argv[++i];
+        }
+        else if (strcmp(argv[i], "-seed") == 0 && i + 1 < argc) {
+            graine_globale = strtoull(argv[++i], NULL, 10);
+            graine_donnee = true;
+        }
+        else if (strcmp(argv[i], "-checkpoint") == 0 && i + 1 < argc) {
+            fichier_point_reprise = argv[++i];
+        }
+        else if (strcmp(argv[i], "-pc") == 0 && i + 1 < argc) {
+            periode_point_reprise = atof(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "--resume") == 0 || strcmp(argv[i], "-resume") == 0) && i + 1 < argc) {
+            fichier_reprise = argv[++i];
+        }
+        else if (strcmp(argv[i], "-adaptatif") == 0) {
+            controle_adaptatif = true;
+        }
+        else if (strcmp(argv[i], "-regions") == 0 && i + 1 < argc) {
+            n_regions = max(1, atoi(argv[++i]));
+        }
+        else if (strcmp(argv[i], "-relinking") == 0 && i + 1 < argc) {
+            taille_elite = max(0, atoi(argv[++i]));
+        }
+        else if (strcmp(argv[i], "-exact") == 0 && i + 1 < argc) {
+            temps_exact_limit = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-solveur") == 0 && i + 1 < argc) {
+            string solveur = argv[++i];
+            if (solveur == "cplex") solveur_natif = false;
+            else if (solveur == "natif") solveur_natif = true;
+            else {
+                JOURNAL_ERREUR << "Erreur: solveur inconnu (cplex, natif)";
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "-bnb_threads") == 0 && i + 1 < argc) {
+            threads_bnb = max(1, atoi(argv[++i]));
+        }
+        else if (strcmp(argv[i], "-cc") == 0) {
+            decomposition_composantes = true;
+        }
+        else if (strcmp(argv[i], "-cc_exact") == 0 && i + 1 < argc) {
+            taille_max_exacte = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-multiniveau") == 0 && i + 1 < argc) {
+            taille_multiniveau = max(0, atoi(argv[++i]));
+        }
+        else if (strcmp(argv[i], "-threads") == 0 && i + 1 < argc) {
+            n_threads = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-coop") == 0 && i + 1 < argc) {
+            nom_coop = argv[++i];
+        }
+        else if (strcmp(argv[i], "-coop_periode") == 0 && i + 1 < argc) {
+            periode_coop = atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-niveau") == 0 && i + 1 < argc) {
+            string niveau = argv[++i];
+            if (niveau == "erreur") AsyncLog::instance().setLevel(LOG_ERROR);
+            else if (niveau == "info") AsyncLog::instance().setLevel(LOG_INFO);
+            else if (niveau == "debug") AsyncLog::instance().setLevel(LOG_DEBUG);
+            else {
+                JOURNAL_ERREUR << "Erreur: -niveau attend erreur, info ou debug";
+                return 1;
+            }
+        }
+    }
+
+    if (!socket_serveur.empty()) {
+        if (!fichier_seuils.empty()) {
+            JOURNAL_ERREUR << "Erreur: -seuils n'est pas disponible avec -serve";
+            return 1;
+        }
+#ifndef _WIN32
+        return servir(socket_serveur);
+#else
+        JOURNAL_ERREUR << "Erreur: -serve n'est pas disponible sous Windows";
+        return 1;
+#endif
     }
 
     if (option_mode == "") {
-         cout << "Erreur: veuillez specifier un mode (-i ou -c)" << endl;
+         JOURNAL_ERREUR << "Erreur: veuillez specifier un mode (-i ou -c)";
          afficher_aide();
          return 1;
     }
 
     if (fichier_entree.empty()) {
-        cout << "Erreur: veuillez specifier un fichier d'entree" << endl;
+        JOURNAL_ERREUR << "Erreur: veuillez specifier un fichier d'entree";
         return 1;
     }
 
-    // Initialiser le générateur aléatoire
-    srand(time(NULL));
+    // Initialiser le générateur aléatoire (affiché pour pouvoir rejouer le run avec -seed)
+    if (!graine_donnee) {
+        graine_globale = chrono::system_clock::now().time_since_epoch().count();
+    }
+    flux_racine = FluxAleatoire(graine_globale);
 
     if (option_mode == "-c") {
         // MODE CONVERSION : matrice -> liste d'arêtes
-        cout << "MODE CONVERSION" << endl;
-        cout << "Conversion du fichier : " << fichier_entree << endl;
+        JOURNAL_CONSOLE << "MODE CONVERSION";
+        JOURNAL_CONSOLE << "Conversion du fichier : " << fichier_entree;
 
         if (convertir_matrice_vers_liste_aretes(fichier_entree)) {
-            cout << "Conversion terminée avec succès !" << endl;
+            JOURNAL_CONSOLE << "Conversion terminée avec succès !";
         } else {
-            cout << "Échec de la conversion." << endl;
+            JOURNAL_ERREUR << "Échec de la conversion.";
             return 1;
         }
 
@@ -1309,102 +5396,471 @@ int main(int argc, char** argv) {
 
     } else if (option_mode == "-i") {
         // MODE EXECUTION : algorithme sur liste d'arêtes
-        cout << "MODE EXECUTION DE L'ALGORITHME" << endl;
+        JOURNAL_CONSOLE << "MODE EXECUTION DE L'ALGORITHME";
+
+        // Solution précédente lue avant l'ouverture du log, qui peut être le même fichier
+        Solution precedente;
+        if (!fichier_precedente.empty() &&
+            !lire_solution(fichier_precedente, numeric_limits<int>::max(), precedente)) {
+            JOURNAL_ERREUR << "Erreur: solution precedente illisible: " << fichier_precedente;
+            return 1;
+        }
 
         // Ouvrir le fichier de log
         string logFilename = fichier_entree + "OUTPUT_LocalBranching";
-        ofstream logFile(logFilename.c_str());
+        LogFile logFile(logFilename);
 
-        // Lire le graphe depuis le fichier liste d'arêtes
+        // Lire le graphe depuis le fichier (liste d'arêtes ou matrice d'adjacence)
         lire_graphe(fichier_entree, n_sommets, voisins);
+        JOURNAL(logFile) << "Graphe: " << n_sommets << " sommets, " << nombre_aretes() << " aretes, listes compressees "
+                         << taille_memoire(voisins.bytes());
+        if (!fichier_seuils.empty() && !lire_seuils(fichier_seuils)) {
+            JOURNAL_ERREUR << "Erreur: seuils illisibles ou en nombre different de n: " << fichier_seuils;
+            return 1;
+        }
+
+        // fichier_point_reprise est propre au thread : les workers -cc ne l'écriraient pas
+        if (decomposition_composantes && !fichier_point_reprise.empty()) {
+            JOURNAL_ERREUR << "Erreur: -checkpoint n'est pas disponible avec -cc";
+            return 1;
+        }
+
+        // Reprise : les paramètres du run interrompu remplacent ceux de la ligne de commande
+        PointReprise reprise;
+        if (!fichier_reprise.empty()) {
+            if (!lire_point_reprise(fichier_reprise, reprise)) {
+                JOURNAL_ERREUR << "Erreur: point de reprise illisible: " << fichier_reprise;
+                return 1;
+            }
+            // Le graphe lui-même est comparé après la renumérotation (empreinte_graphe)
+            if (reprise.n != n_sommets) {
+                JOURNAL_ERREUR << "Erreur: le point de reprise ne correspond pas a l'instance " << fichier_entree;
+                return 1;
+            }
+            if (decomposition_composantes) {
+                JOURNAL_ERREUR << "Erreur: --resume n'est pas disponible avec -cc";
+                return 1;
+            }
+            temps_total_limit = reprise.temps_total;
+            alpha = reprise.alpha;
+            param_beta = reprise.beta;
+            k = reprise.k;
+            temps_intensification_limit = reprise.temps_intensif;
+            temps_diversification_limit = reprise.temps_diversif;
+            controle_adaptatif = reprise.adaptatif;
+            ordre_renumerotation = reprise.ordre;
+            rho = reprise.rho;
+            if (fichier_point_reprise.empty()) fichier_point_reprise = fichier_reprise;
+        }
+
+        if (taille_multiniveau > 0 &&
+            (decomposition_composantes || !fichier_reprise.empty() || !fichier_delta.empty() || !nom_coop.empty())) {
+            JOURNAL_ERREUR << "Erreur: -multiniveau n'est pas disponible avec -cc, --resume, -delta ni -coop";
+            return 1;
+        }
+
+        preparer_graphe();
+
+        // Mode incrémental : delta d'arêtes appliqué en place, réparation locale
+        Solution solution_reparee;
+        if (!fichier_delta.empty()) {
+            if (fichier_precedente.empty() || !fichier_reprise.empty() || decomposition_composantes) {
+                JOURNAL_ERREUR << "Erreur: -delta demande -precedente et n'est pas disponible avec --resume ni -cc";
+                return 1;
+            }
+            if (!precedente.vertices.empty() && *precedente.vertices.rbegin() >= n_sommets) {
+                JOURNAL_ERREUR << "Erreur: la solution precedente ne correspond pas a l'instance";
+                return 1;
+            }
+
+            chrono::steady_clock::time_point debut_delta = chrono::steady_clock::now();
+            vector<int> touches;
+            int n_ajouts, n_suppressions;
+            if (!appliquer_delta(fichier_delta, touches, n_ajouts, n_suppressions)) {
+                JOURNAL_ERREUR << "Erreur: delta illisible: " << fichier_delta;
+                return 1;
+            }
+            solution_reparee = reparer_solution(precedente, touches);
+
+            ostringstream oss;
+            oss << "Delta: " << n_ajouts << " aretes ajoutees, " << n_suppressions << " supprimees, "
+                << touches.size() << " sommets touches; solution " << precedente.score << " -> "
+                << solution_reparee.score << " apres reparation (" << 1000.0 * secondes_depuis(debut_delta)
+                << " ms)";
+            JOURNAL(logFile) << oss.str();
+
+            if (!fichier_graphe_mis_a_jour.empty() && !ecrire_graphe(fichier_graphe_mis_a_jour)) {
+                JOURNAL_ERREUR << "Erreur: impossible d'ecrire " << fichier_graphe_mis_a_jour;
+            }
+
+            // Budget court par défaut : la solution réparée est déjà proche
+            if (!temps_total_donne) temps_total_limit = 10.0;
+        }
+
+        if (repetitions_banc > 0) {
+            if (!graine_donnee) graine_globale = 1;
+            banc_ordres(repetitions_banc);
+            return 0;
+        }
+
+        if (bits_actifs()) {
+            JOURNAL(logFile) << "Adjacence: lignes de bits (" << adjacence_bits.mots << " mots par sommet)";
+        }
+
+        // Renumérotation : tout le calcul se fait sur les nouveaux identifiants
+        vector<int> ordre_sommets;
+        if (ordre_renumerotation != ORDRE_AUCUN) {
+            chrono::steady_clock::time_point debut_ordre = chrono::steady_clock::now();
+            ordre_sommets = calculer_ordre(ordre_renumerotation);
+            renumeroter_graphe(ordre_sommets);
+            if (!fichier_delta.empty()) {
+                solution_reparee = renumeroter_solution(solution_reparee, inverser_ordre(ordre_sommets));
+            }
+            JOURNAL(logFile) << "Renumerotation " << noms_ordre[ordre_renumerotation] << ": "
+                             << 1000.0 * secondes_depuis(debut_ordre) << " ms";
+        }
+        if (!fichier_reprise.empty() && reprise.empreinte != empreinte_graphe()) {
+            JOURNAL_ERREUR << "Erreur: le point de reprise ne correspond pas a l'instance " << fichier_entree;
+            return 1;
+        }
 
-        cout << "========================================" << endl;
-        cout << "Local Branching pour PIDS" << endl;
-        cout << "Instance: " << fichier_entree << endl;
-        cout << "Nombre de sommets: " << n_sommets << endl;
-        cout << "Temps limite: " << temps_total_limit << " secondes" << endl;
-        cout << "Parametres: alpha=" << alpha << ", beta=" << param_beta << ", k=" << k << endl;
-        cout << "Temps Intensif: " << temps_intensification_limit << ", Temps Diversif: " << temps_diversification_limit << endl;
-        cout << "========================================" << endl;
-
-        if (logFile.is_open()) {
-            logFile << "========================================" << endl;
-            logFile << "Local Branching pour PIDS" << endl;
-            logFile << "Instance: " << fichier_entree << endl;
-            logFile << "Nombre de sommets: " << n_sommets << endl;
-            logFile << "Temps limite: " << temps_total_limit << " secondes" << endl;
-            logFile << "Parametres: alpha=" << alpha << ", beta=" << param_beta << ", k=" << k << endl;
-            logFile << "Temps Intensif: " << temps_intensification_limit << ", Temps Diversif: " << temps_diversification_limit << endl;
-            logFile << "========================================" << endl;
+        JOURNAL(logFile) << "========================================";
+        JOURNAL(logFile) << "Local Branching pour PIDS";
+        JOURNAL(logFile) << "Instance: " << fichier_entree;
+        JOURNAL(logFile) << "Nombre de sommets: " << n_sommets;
+        JOURNAL(logFile) << "Temps limite: " << temps_total_limit << " secondes";
+        JOURNAL(logFile) << "Parametres: alpha=" << alpha << ", beta=" << param_beta << ", k=" << k;
+        JOURNAL(logFile) << "Temps Intensif: " << temps_intensification_limit << ", Temps Diversif: " << temps_diversification_limit;
+        JOURNAL(logFile) << "Graine: " << graine_globale;
+        JOURNAL(logFile) << "========================================";
+
+        // Coopération : publication de chaque amélioration, adoption de la solution commune
+        if (!nom_coop.empty()) {
+#ifndef _WIN32
+            string erreur;
+            if (decomposition_composantes || !attacher_coop(nom_coop, ordre_sommets, erreur)) {
+                JOURNAL_ERREUR << "Erreur: -coop " << (decomposition_composantes ? "n'est pas disponible avec -cc" : erreur);
+                return 1;
+            }
+            JOURNAL(logFile) << "Cooperation: " << (coop.mode == COOP_MEMOIRE ? "memoire partagee " : "socket ")
+                             << (coop.mode == COOP_MEMOIRE ? nom_coop : coop.chemin);
+            rappel_amelioration = publier_solution_coop;
+            rappel_adoption = adopter_solution_coop;
+            prefixe_fichiers_cplex = "p" + to_string(getpid()) + "_";  // Processus lancés dans le même répertoire
+#else
+            JOURNAL_ERREUR << "Erreur: -coop n'est pas disponible sous Windows";
+            return 1;
+#endif
         }
 
         // Mesurer le temps global
-        clock_t start_time = clock();
+        chrono::steady_clock::time_point start_time = chrono::steady_clock::now();
 
         // Exécuter l'algorithme
-        Solution meilleure_solution = algorithme_local_branching(logFile);
+        Solution meilleure_solution;
+        if (decomposition_composantes) {
+            meilleure_solution = resoudre_par_composantes(logFile);
+        } else if (taille_multiniveau > 0) {
+            meilleure_solution = resoudre_multiniveau(logFile);
+        } else {
+            meilleure_solution = algorithme_local_branching(logFile, temps_total_limit,
+                                                            fichier_reprise.empty() ? NULL : &reprise,
+                                                            fichier_delta.empty() ? NULL : &solution_reparee);
+        }
 
-        clock_t end_time = clock();
-        double total_time = double(end_time - start_time) / CLOCKS_PER_SEC;
+        if (temps_exact_limit > 0.0) {
+            meilleure_solution = resolution_exacte(meilleure_solution, temps_exact_limit, logFile);
+        }
 
-        // Afficher les résultats
-        cout << "\n=== RESULTATS FINAUX ===" << endl;
-        cout << "Score optimal: " << meilleure_solution.score << endl;
-        cout << "Nombre de sommets selectionnes: " << meilleure_solution.vertices.size() << endl;
-        cout << "Temps total d'execution: " << total_time << " secondes" << endl;
+#ifndef _WIN32
+        if (coop.mode != COOP_AUCUN) {
+            if (temps_exact_limit > 0.0) publier_solution_coop(meilleure_solution);
+            JOURNAL(logFile) << "Cooperation: " << coop.publiees << " solutions publiees, "
+                             << coop.adoptees << " adoptees";
+            rappel_amelioration = nullptr;
+            rappel_adoption = nullptr;
+            detacher_coop();
+        }
+#endif
 
-        if (logFile.is_open()) {
-            logFile << "\n=== RESULTATS FINAUX ===" << endl;
-            logFile << "Score optimal: " << meilleure_solution.score << endl;
-            logFile << "Temps total d'execution: " << total_time << " secondes" << endl;
+        // Retour aux identifiants d'origine pour l'affichage et la vérification
+        if (!ordre_sommets.empty()) {
+            meilleure_solution = renumeroter_solution(meilleure_solution, ordre_sommets);
+            renumeroter_graphe(inverser_ordre(ordre_sommets));
         }
 
+        double total_time = secondes_depuis(start_time);
+
+        // Afficher les résultats : en texte brut après tout le journal de la recherche
+        // (-precedente relit la ligne "Sommets selectionnes:" du fichier OUTPUT)
+        ostringstream resultats;
+        resultats << "\n=== RESULTATS FINAUX ===\n";
+        resultats << "Score optimal: " << meilleure_solution.score << "\n";
+        ostringstream suite;
+        suite << "Temps total d'execution: " << total_time << " secondes\n";
+
         vector<int> sommets_tries(meilleure_solution.vertices.begin(),
                                  meilleure_solution.vertices.end());
         sort(sommets_tries.begin(), sommets_tries.end());
 
-        cout << "Sommets selectionnes: ";
-        if (logFile.is_open()) logFile << "Sommets selectionnes: ";
-        
+        suite << "Sommets selectionnes: ";
         for (size_t i = 0; i < sommets_tries.size(); ++i) {
-            cout << sommets_tries[i];
-            if (logFile.is_open()) logFile << sommets_tries[i];
-            
-            if (i < sommets_tries.size() - 1) {
-                cout << " ";
-                if (logFile.is_open()) logFile << " ";
-            }
+            suite << sommets_tries[i];
+            if (i < sommets_tries.size() - 1) suite << " ";
         }
-        cout << endl;
-        if (logFile.is_open()) logFile << endl;
+        suite << "\n";
 
         // Vérification de la solution
         bool solution_valide = true;
         for (int i = 0; i < n_sommets; ++i) {
             if (!est_domine(i, meilleure_solution)) {
                 solution_valide = false;
-                cout << "ERREUR: Sommet " << i << " non domine!" << endl;
-                if (logFile.is_open()) logFile << "ERREUR: Sommet " << i << " non domine!" << endl;
+                suite << "ERREUR: Sommet " << i << " non domine!\n";
                 break;
             }
         }
 
         if (solution_valide) {
-            cout << "Solution verifiee: tous les sommets sont domines." << endl;
-            if (logFile.is_open()) logFile << "Solution verifiee: tous les sommets sont domines." << endl;
+            suite << "Solution verifiee: tous les sommets sont domines.\n";
         } else {
-            cout << "ATTENTION: Solution invalide!" << endl;
-            if (logFile.is_open()) logFile << "ATTENTION: Solution invalide!" << endl;
+            suite << "ATTENTION: Solution invalide!\n";
         }
+        AsyncLog::instance().writeConsole(resultats.str() + "Nombre de sommets selectionnes: " +
+                                          to_string(meilleure_solution.vertices.size()) + "\n" + suite.str());
 
-        if (logFile.is_open()) logFile.close();
+        logFile.writeDirect(resultats.str() + suite.str());
+        logFile.close();
 
         return 0;
 
     } else {
         // Option invalide
         // Should be caught by option_mode check above, but for safety:
-        cout << "Erreur: mode inconnu" << endl;
+        JOURNAL_ERREUR << "Erreur: mode inconnu";
         return 1;
     }
 }
+#endif
+
+
+
+
+// ====================================================
+// BIBLIOTHÈQUE libpids (API C, voir libpids.h)
+// ====================================================
+
+#ifdef LIBPIDS
+
+/*
+ * Un contexte porte tout ce qu'une résolution lit habituellement dans les variables
+ * thread_local : graphe, paramètres, préfixe des fichiers CPLEX. pids_solve les
+ * installe dans le thread appelant le temps de la résolution puis rétablit les
+ * précédents, d'où la réentrance entre contextes.
+ */
+struct pids_context {
+    int id;
+    int n;
+    CompressedAdjacency voisins;
+    ParametresPIDS parametres;
+    atomic<bool> annulation;
+    atomic<bool> en_cours;
+    mutex verrou;              // Protège meilleure (lue pendant une résolution)
+    Solution meilleure;
+    bool a_solution;
+    string erreur;
+};
+
+static atomic<int> prochain_contexte(0);
+
+// Valeurs par défaut : celles d'un thread neuf, lues au chargement avant tout appel
+static const ParametresPIDS parametres_defaut = capturer_parametres();
+
+extern "C" pids_context* pids_create(void) {
+    pids_context* ctx = new pids_context();
+    ctx->id = prochain_contexte.fetch_add(1);
+    ctx->n = 0;
+    ctx->annulation = false;
+    ctx->en_cours = false;
+    ctx->a_solution = false;
+    ctx->parametres = parametres_defaut;
+    return ctx;
+}
+
+extern "C" void pids_destroy(pids_context* ctx) {
+    delete ctx;
+}
+
+static void nouveau_graphe(pids_context* ctx, int n, CompressedAdjacency& graphe) {
+    ctx->n = n;
+    ctx->voisins.swap(graphe);
+    lock_guard<mutex> verrou(ctx->verrou);
+    ctx->a_solution = false;
+    ctx->meilleure = Solution();
+}
+
+extern "C" int pids_load_edges(pids_context* ctx, int n, const int* edges, int m) {
+    if (!ctx || n <= 0 || m < 0 || (m > 0 && !edges)) return PIDS_ERR_ARGUMENT;
+    if (ctx->en_cours) return PIDS_ERR_BUSY;
+    for (int e = 0; e < 2 * m; ++e) {
+        if (edges[e] < 0 || edges[e] >= n) {
+            ctx->erreur = "sommet hors de [0, n) dans la liste d'aretes";
+            return PIDS_ERR_GRAPH;
+        }
+    }
+    vector<uint64_t> debut(n + 1, 0);
+    for (int e = 0; e < 2 * m; ++e) debut[edges[e] + 1]++;
+    for (int i = 0; i < n; ++i) debut[i + 1] += debut[i];
+    vector<int> cibles(debut[n]);
+    vector<uint64_t> position(debut.begin(), debut.end() - 1);
+    for (int e = 0; e < m; ++e) {
+        int u = edges[2 * e], v = edges[2 * e + 1];
+        cibles[position[u]++] = v;
+        cibles[position[v]++] = u;
+    }
+    CompressedAdjacency graphe;
+    graphe.build(n, debut, cibles);  // Doublons et boucles retirés
+    nouveau_graphe(ctx, n, graphe);
+    return PIDS_OK;
+}
+
+extern "C" int pids_load_buffer(pids_context* ctx, const char* data, size_t size) {
+    if (!ctx || !data) return PIDS_ERR_ARGUMENT;
+    if (ctx->en_cours) return PIDS_ERR_BUSY;
+
+    int n;
+    CompressedAdjacency graphe;
+    if (!lire_graphe_tampon(data, data + size, n, graphe, ctx->erreur)) return PIDS_ERR_GRAPH;
+    nouveau_graphe(ctx, n, graphe);
+    return PIDS_OK;
+}
+
+extern "C" int pids_set_param(pids_context* ctx, const char* name, double value) {
+    if (!ctx || !name) return PIDS_ERR_ARGUMENT;
+    if (ctx->en_cours) return PIDS_ERR_BUSY;
+
+    ParametresPIDS& p = ctx->parametres;
+    string nom = name;
+    if (nom == "t") p.temps_total_limit = value;
+    else if (nom == "ti") p.temps_intensification_limit = value;
+    else if (nom == "td") p.temps_diversification_limit = value;
+    else if (nom == "a") p.alpha = value;
+    else if (nom == "b") p.param_beta = value;
+    else if (nom == "k") p.k = (int)value;
+    else if (nom == "seed") {
+        p.graine_globale = (uint64_t)value;
+        p.graine_donnee = true;
+    }
+    else if (nom == "threads") p.n_threads = max(1, (int)value);
+    else if (nom == "regions") p.n_regions = max(1, (int)value);
+    else if (nom == "gap") p.gap_cible = value;
+    else if (nom == "voisinage" && value >= 0 && value < N_VOISINAGES) p.generateur_voisinage = (int)value;
+    else if (nom == "lbc" && value >= LB_AUCUNE && value <= LB_SEULE) p.mode_contrainte_lb = (int)value;
+    else if (nom == "adaptatif") p.controle_adaptatif = value != 0;
+    else if (nom == "rho" && value > 0.0 && value <= 1.0) p.rho = value;
+    else if (nom == "solveur" && (value == 0 || value == 1)) p.solveur_natif = value == 1;
+    else if (nom == "bnb_threads" && value >= 1) p.threads_bnb = (int)value;
+    else if (nom == "relinking" && value >= 0) p.taille_elite = (int)value;
+    else {
+        ctx->erreur = "parametre inconnu ou valeur invalide: " + nom;
+        return PIDS_ERR_ARGUMENT;
+    }
+    return PIDS_OK;
+}
+
+extern "C" int pids_set_seed(pids_context* ctx, uint64_t seed) {
+    if (!ctx) return PIDS_ERR_ARGUMENT;
+    if (ctx->en_cours) return PIDS_ERR_BUSY;
+    ctx->parametres.graine_globale = seed;
+    ctx->parametres.graine_donnee = true;
+    return PIDS_OK;
+}
+
+extern "C" int pids_solve(pids_context* ctx, pids_improvement_cb callback, void* user_data) {
+    if (!ctx) return PIDS_ERR_ARGUMENT;
+    if (ctx->n <= 0) {
+        ctx->erreur = "aucun graphe charge";
+        return PIDS_ERR_GRAPH;
+    }
+    bool libre = false;
+    if (!ctx->en_cours.compare_exchange_strong(libre, true)) return PIDS_ERR_BUSY;
+    ctx->annulation = false;
+
+    // Installation du contexte dans le thread appelant
+    ParametresPIDS parametres_appelant = capturer_parametres();
+    string prefixe_appelant = prefixe_fichiers_cplex;
+    FluxAleatoire flux_appelant = flux_racine;
+
+    installer_parametres(ctx->parametres);
+    swap(n_sommets, ctx->n);
+    voisins.swap(ctx->voisins);
+    etat_contrainte_lb = EtatContrainteLB();
+    preparer_graphe();
+    prefixe_fichiers_cplex = "pids" + to_string(ctx->id) + "_";
+    flux_racine = FluxAleatoire(graine_donnee ? graine_globale
+                                              : chrono::system_clock::now().time_since_epoch().count());
+    jeton_annulation = &ctx->annulation;
+    rappel_amelioration = [&](const Solution& sol) {
+        {
+            lock_guard<mutex> verrou(ctx->verrou);
+            ctx->meilleure = sol;
+            ctx->a_solution = true;
+        }
+        if (callback) {
+            vector<int> sommets(sol.vertices.begin(), sol.vertices.end());
+            callback(sommets.data(), sommets.size(), user_data);
+        }
+    };
+
+    // Un nouveau solve sur le même graphe repart de la meilleure solution connue
+    Solution depart;
+    {
+        lock_guard<mutex> verrou(ctx->verrou);
+        if (ctx->a_solution) depart = ctx->meilleure;
+    }
+
+    LogFile pas_de_log;
+    Solution resultat = algorithme_local_branching(pas_de_log, temps_total_limit, NULL,
+                                                   depart.vertices.empty() ? NULL : &depart);
+    {
+        lock_guard<mutex> verrou(ctx->verrou);
+        ctx->meilleure = resultat;
+        ctx->a_solution = true;
+    }
+
+    // Rétablissement de l'état du thread appelant
+    rappel_amelioration = nullptr;
+    jeton_annulation = NULL;
+    voisins.swap(ctx->voisins);
+    swap(n_sommets, ctx->n);
+    etat_contrainte_lb = EtatContrainteLB();
+    installer_parametres(parametres_appelant);
+    preparer_graphe();
+    prefixe_fichiers_cplex = prefixe_appelant;
+    flux_racine = flux_appelant;
+
+    ctx->en_cours = false;
+    return resultat.score;
+}
+
+extern "C" void pids_cancel(pids_context* ctx) {
+    if (ctx) ctx->annulation = true;
+}
+
+extern "C" int pids_best_solution(pids_context* ctx, int* vertices, int capacity) {
+    if (!ctx) return -1;
+    lock_guard<mutex> verrou(ctx->verrou);
+    if (!ctx->a_solution) return -1;
+    int i = 0;
+    for (set<int>::const_iterator it = ctx->meilleure.vertices.begin();
+         it != ctx->meilleure.vertices.end() && i < capacity; ++it) {
+        if (vertices) vertices[i] = *it;
+        ++i;
+    }
+    return ctx->meilleure.vertices.size();
+}
+
+extern "C" const char* pids_last_error(const pids_context* ctx) {
+    return ctx ? ctx->erreur.c_str() : "contexte nul";
+}
+
+#endif
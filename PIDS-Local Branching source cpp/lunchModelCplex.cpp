@@ -6,6 +6,10 @@
 #include <cstdlib>
 #include <cstdio>
 #include <chrono>
+#include <sstream>
+#include <algorithm>
+#include "buffered_writer.h"
+#include "pids_bnb.h"
 
 using namespace std;
 using namespace std::chrono;
@@ -24,6 +28,136 @@ string getCplexPath() {
 
 const string CPLEX_PATH = getCplexPath();
 
+// Read an initial solution: either the "Sommets selectionnes:" line of a
+// *OUTPUT_LocalBranching file (0-based ids) or "xK  1.000000" lines as in the
+// "Solution:" section of a *OUTPUT file (1-based names). Returns 0-based ids.
+vector<int> readStartSolution(const string& filename, int n) {
+    ifstream file(filename);
+    if (!file.is_open()) {
+        cerr << "Error opening start solution: " << filename << endl;
+        exit(1);
+    }
+
+    vector<int> fromLocalBranching, fromCplex;
+    string line;
+    while (getline(file, line)) {
+        size_t pos = line.find("Sommets selectionnes:");
+        if (pos != string::npos) {
+            fromLocalBranching.clear(); // keep the last one
+            stringstream ss(line.substr(pos + 21));
+            int v;
+            while (ss >> v) {
+                if (v >= 0 && v < n) fromLocalBranching.push_back(v);
+            }
+        } else if (line.size() > 1 && line[0] == 'x' && isdigit(line[1])) {
+            stringstream ss(line.substr(1));
+            int idx;
+            double val;
+            if (ss >> idx >> val && val > 0.5 && idx >= 1 && idx <= n) fromCplex.push_back(idx - 1);
+        }
+    }
+    return fromLocalBranching.empty() ? fromCplex : fromLocalBranching;
+}
+
+// ceil(rho * deg) without the rounding error of rho * deg (0.55 * 100 > 55)
+int threshold(double rho, int deg) {
+    return (int)ceil(rho * deg - 1e-9);
+}
+
+// Binomial coefficient as a double (only compared against a small cap)
+double binomial(int n, int r) {
+    if (r < 0 || r > n) return 0.0;
+    double c = 1.0;
+    for (int t = 1; t <= r; t++) c = c * (n - r + t) / t;
+    return c;
+}
+
+// Cover inequalities for vertex i: if x_i = 0, at most deg_i - rhs neighbours
+// may be 0, so every set T of deg_i - rhs + 1 neighbours holds a selected one:
+//     sum_{j in T} x_j + x_i >= 1
+// All sets are written when there are at most maxCuts of them, otherwise the
+// cyclic windows of the neighbour list. Returns the number of cuts written.
+int writeCoverCuts(BufferedWriter& lpFile, int i, const vector<int>& neighbors, int rhs,
+                   int maxCuts, int& cutId) {
+    int d = neighbors.size();
+    int t = d - rhs + 1;
+    if (rhs <= 1 || t <= 0) return 0; // rhs = 1 is the original constraint
+
+    int written = 0;
+    if (binomial(d, t) <= maxCuts) {
+        vector<int> idx(t);
+        for (int q = 0; q < t; q++) idx[q] = q;
+        while (true) {
+            lpFile.put(" cov").putInt(++cutId).put(": ");
+            for (int q = 0; q < t; q++) lpFile.putVar(neighbors[idx[q]]).put(" + ");
+            lpFile.putVar(i).put(" >= 1\n");
+            written++;
+
+            int q = t - 1;
+            while (q >= 0 && idx[q] == d - t + q) q--;
+            if (q < 0) break;
+            idx[q]++;
+            for (int r = q + 1; r < t; r++) idx[r] = idx[r - 1] + 1;
+        }
+    } else {
+        int windows = min(d, maxCuts);
+        for (int s = 0; s < windows; s++) {
+            lpFile.put(" cov").putInt(++cutId).put(": ");
+            for (int q = 0; q < t; q++) lpFile.putVar(neighbors[(s + q) % d]).put(" + ");
+            lpFile.putVar(i).put(" >= 1\n");
+            written++;
+        }
+    }
+    return written;
+}
+
+// A cover inequality sum_{j in T} x_j + x_i >= 1 found by separation
+struct CoverCut {
+    int vertex;
+    vector<int> set;
+};
+
+// Exact separation of the cover family at the LP point x. For vertex i, the
+// cover with the smallest left-hand side takes the deg_i - rhs + 1 neighbours
+// of lowest value, so some cover of i is violated iff this one is. Adds at
+// most one cut per vertex and returns the number added.
+int separateCovers(const vector<vector<int>>& a, int n, double rho, const vector<double>& x,
+                   vector<CoverCut>& cuts) {
+    int added = 0;
+    vector<int> neighbors;
+    neighbors.reserve(n);
+    for (int i = 0; i < n; i++) {
+        neighbors.clear();
+        for (int j = 0; j < n; j++) {
+            if (a[i][j] == 1) neighbors.push_back(j);
+        }
+        int d = neighbors.size();
+        int rhs = threshold(rho, d);
+        int t = d - rhs + 1;
+        if (rhs <= 1 || t <= 0) continue;
+
+        nth_element(neighbors.begin(), neighbors.begin() + (t - 1), neighbors.end(),
+                    [&](int u, int v) { return x[u] < x[v]; });
+        double lhs = x[i];
+        for (int q = 0; q < t; q++) lhs += x[neighbors[q]];
+        if (lhs < 1.0 - 1e-6) {
+            CoverCut cut;
+            cut.vertex = i;
+            cut.set.assign(neighbors.begin(), neighbors.begin() + t);
+            sort(cut.set.begin(), cut.set.end());
+            cuts.push_back(cut);
+            added++;
+        }
+    }
+    return added;
+}
+
+void writeCut(BufferedWriter& lpFile, const CoverCut& cut, int id) {
+    lpFile.put(" sep").putInt(id).put(": ");
+    for (size_t q = 0; q < cut.set.size(); q++) lpFile.putVar(cut.set[q]).put(" + ");
+    lpFile.putVar(cut.vertex).put(" >= 1\n");
+}
+
 // Function to read the instance
 vector<vector<int>> readInstance(const string& filename, int& n, int& m) {
     ifstream file(filename);
@@ -55,6 +189,198 @@ vector<vector<int>> readInstance(const string& filename, int& n, int& m) {
     return adj;
 }
 
+// Prints the results and saves them to <instance>OUTPUT
+void writeResults(const string& filename, const string& objective, const string& gap, int cardinality,
+                  const vector<string>& solutionLines) {
+    cout << "\n--- Final Results ---" << endl;
+    cout << "Objective: " << objective << endl;
+    cout << "Gap: " << gap << endl;
+    cout << "Cardinality: " << cardinality << endl;
+    cout << "Solution: " << endl;
+    for (size_t i = 0; i < solutionLines.size(); ++i) {
+        cout << solutionLines[i] << endl;
+    }
+
+    string outputFilename = filename + "OUTPUT";
+    ofstream outFile(outputFilename.c_str());
+    if (outFile.is_open()) {
+        outFile << "Objective: " << objective << endl;
+        outFile << "Gap: " << gap << endl;
+        outFile << "Cardinality: " << cardinality << endl;
+        outFile << "Solution: " << endl;
+        for (size_t i = 0; i < solutionLines.size(); ++i) {
+            outFile << solutionLines[i] << endl;
+        }
+        outFile.close();
+        cout << "Results saved to " << outputFilename << endl;
+    } else {
+        cerr << "Error saving results to " << outputFilename << endl;
+    }
+}
+
+// Writes the model: Big-M rows, the cover cuts of -form desagregee and the
+// separated covers, the cuts in the "User Cuts" section with lazyCuts.
+// Returns false if the file could not be written.
+bool writeModel(const string& lpFilename, const vector<vector<int>>& a, int n, double rho, bool withCovers,
+                bool lazyCuts, int maxCutsPerVertex, const vector<CoverCut>& separated, int& cutCount) {
+    BufferedWriter lpFile;
+    if (!lpFile.open(lpFilename)) return false;
+
+    // LP Header
+    lpFile.put("Minimize\n obj: ");
+    for (int i = 0; i < n; i++) {
+        lpFile.putVar(i);
+        if (i < n - 1) lpFile.put(" + ");
+    }
+    lpFile.put("\nSubject To\n");
+
+    int cutId = 0;
+    vector<int> neighbors;  // Reused for every row
+    neighbors.reserve(n);
+
+    for (int i = 0; i < n; i++) {
+        neighbors.clear();
+        for (int j = 0; j < n; j++) {
+            if (a[i][j] == 1) neighbors.push_back(j);
+        }
+        int deg_i = neighbors.size();
+
+        // Constraint: sum(x_j) + M*x_i >= ceil(rho * deg_i)
+        int rhs = threshold(rho, deg_i);
+
+        lpFile.put(" c").putInt(i + 1).put(": ");
+        for (size_t k = 0; k < neighbors.size(); k++) {
+            lpFile.putVar(neighbors[k]).put(" + ");
+        }
+        // Use rhs as the coefficient for x[i] (Big-M)
+        lpFile.putInt(rhs).put(' ').putVar(i).put(" >= ").putInt(rhs).put('\n');
+
+        if (withCovers && !lazyCuts) {
+            writeCoverCuts(lpFile, i, neighbors, rhs, maxCutsPerVertex, cutId);
+        }
+    }
+    if (!lazyCuts) {
+        for (size_t k = 0; k < separated.size(); k++) writeCut(lpFile, separated[k], k + 1);
+    }
+
+    if (withCovers && lazyCuts) {
+        // CPLEX only adds a user cut to the LP when it is violated
+        lpFile.put("User Cuts\n");
+        for (int i = 0; i < n; i++) {
+            neighbors.clear();
+            for (int j = 0; j < n; j++) {
+                if (a[i][j] == 1) neighbors.push_back(j);
+            }
+            int rhs = threshold(rho, neighbors.size());
+            writeCoverCuts(lpFile, i, neighbors, rhs, maxCutsPerVertex, cutId);
+        }
+        for (size_t k = 0; k < separated.size(); k++) writeCut(lpFile, separated[k], k + 1);
+    }
+    cutCount = cutId + separated.size();
+
+    lpFile.put("Binaries\n");
+    for (int i = 0; i < n; i++) {
+        lpFile.put(' ').putVar(i).put('\n');
+    }
+
+    lpFile.put("End\n");
+    return lpFile.close();
+}
+
+// Solves the LP relaxation of lpFilename with CPLEX. Returns false if no
+// solution could be read; x receives the values, bound the objective.
+bool runLpRelaxation(const string& lpFilename, const string& baseName, int n, vector<double>& x, double& bound) {
+    string scriptFilename = baseName + ".sep.script";
+    string logFilename = baseName + ".sep.log";
+    ofstream scriptFile(scriptFilename.c_str());
+    if (!scriptFile.is_open()) return false;
+    scriptFile << "read " << lpFilename << endl;
+    scriptFile << "change problem lp" << endl;
+    scriptFile << "optimize" << endl;
+    scriptFile << "display solution variables -" << endl;
+    scriptFile << "quit" << endl;
+    scriptFile.close();
+
+    string command = CPLEX_PATH + " -f " + scriptFilename + " > " + logFilename + " 2>&1";
+    if (system(command.c_str()) != 0) return false;
+
+    ifstream logFile(logFilename.c_str());
+    x.assign(n, 0.0);
+    bool found = false;
+    string line;
+    while (getline(logFile, line)) {
+        size_t pos = line.find("Objective =");
+        if (pos != string::npos) {
+            bound = atof(line.c_str() + pos + 11);
+            found = true;
+        } else if (line.size() > 1 && line[0] == 'x' && isdigit(line[1])) {
+            stringstream ss(line.substr(1));
+            int idx;
+            double val;
+            if (ss >> idx >> val && idx >= 1 && idx <= n) x[idx - 1] = val;
+        }
+    }
+    return found;
+}
+
+// Solves the whole instance with the built-in branch-and-bound instead of CPLEX
+// (no LP file, no licence). Same results format, so -start can read it back.
+int solveNative(const string& filename, const vector<vector<int>>& a, int n, double rho,
+                double time_limit, const string& startFilename, int threads) {
+    PidsModel model;
+    model.n = n;
+    model.start.assign(n + 1, 0);
+    model.threshold.assign(n, 0);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            if (a[i][j] == 1) model.targets.push_back(j);
+        }
+        model.start[i + 1] = model.targets.size();
+        model.threshold[i] = threshold(rho, model.start[i + 1] - model.start[i]);
+    }
+
+    PidsBnbOptions options;
+    options.timeLimit = time_limit;
+    options.threads = threads;
+    vector<char> selected;
+    if (!startFilename.empty()) {
+        vector<int> start = readStartSolution(startFilename, n);
+        selected.assign(n, 0);
+        for (size_t k = 0; k < start.size(); k++) selected[start[k]] = 1;
+        options.start = &selected;
+        cout << "Start solution: " << startFilename << " (cardinality " << start.size() << ")" << endl;
+    }
+
+    cout << "Running native branch-and-bound (" << threads << " thread" << (threads > 1 ? "s" : "")
+         << ")..." << endl;
+    auto start = high_resolution_clock::now();
+    PidsBnbResult result = PidsBranchAndBound(model).solve(options);
+    double seconds = duration_cast<milliseconds>(high_resolution_clock::now() - start).count() / 1000.0;
+
+    static const char* const STATUS[] = {"optimal", "infeasible", "time limit, feasible", "time limit, no solution"};
+    cout << "Execution Time: " << seconds << " s" << endl;
+    cout << "Status: " << STATUS[result.status] << ", " << result.nodes << " nodes, bound " << result.bound << endl;
+
+    string objective = "N/A";
+    string gap = "N/A";
+    vector<string> solutionLines;
+    if (!result.selected.empty() || result.value == 0) {
+        objective = to_string(result.value);
+        char buffer[32];
+        double g = result.value > 0 ? 100.0 * (result.value - result.bound) / result.value : 0.0;
+        snprintf(buffer, sizeof(buffer), "%.2f%%", max(g, 0.0));
+        gap = buffer;
+        vector<int> vertices = result.selected;
+        sort(vertices.begin(), vertices.end());
+        for (size_t k = 0; k < vertices.size(); k++) {
+            solutionLines.push_back("x" + to_string(vertices[k] + 1) + "                           1.000000");
+        }
+    }
+
+    writeResults(filename, objective, gap, solutionLines.size(), solutionLines);
+    return 0;
+}
+
 int main(int argc, char** argv) {
    // remove("cplex.log"); // Clear previous log
     string filename;
@@ -70,6 +396,57 @@ int main(int argc, char** argv) {
     if (argc > 2) {
         time_limit = atof(argv[2]);
     }
+
+    // Optional formulation flags
+    string formulation = "bigm"; // bigm | desagregee
+    bool lazyCuts = false;       // Cover cuts in the "User Cuts" pool instead of the model
+    int maxCutsPerVertex = 64;
+    int separationRounds = 0;    // LP solves separating violated covers before the MIP
+    string startFilename;        // Initial solution loaded as a MIP start
+    double rho = 0.5;            // Threshold ceil(rho * deg_i)
+    bool native = false;         // Built-in branch-and-bound instead of CPLEX
+    int threads = 1;
+    for (int i = 3; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "-start" && i + 1 < argc) {
+            startFilename = argv[++i];
+        } else if (arg == "-form" && i + 1 < argc) {
+            formulation = argv[++i];
+        } else if (arg == "-lazy") {
+            lazyCuts = true;
+        } else if (arg == "-maxcuts" && i + 1 < argc) {
+            maxCutsPerVertex = atoi(argv[++i]);
+        } else if (arg == "-sep" && i + 1 < argc) {
+            separationRounds = max(0, atoi(argv[++i]));
+        } else if (arg == "-rho" && i + 1 < argc) {
+            rho = atof(argv[++i]);
+        } else if (arg == "-natif") {
+            native = true;
+        } else if (arg == "-threads" && i + 1 < argc) {
+            threads = max(1, atoi(argv[++i]));
+        }
+    }
+    if (rho <= 0.0 || rho > 1.0) {
+        cerr << "rho must be in (0, 1]" << endl;
+        return 1;
+    }
+    if (formulation != "bigm" && formulation != "desagregee") {
+        cerr << "Unknown formulation: " << formulation << " (bigm | desagregee)" << endl;
+        return 1;
+    }
+    if (separationRounds > 0 && formulation != "desagregee") {
+        cerr << "-sep needs -form desagregee" << endl;
+        return 1;
+    }
+    if (native) {
+        int n, m;
+        cout << "Processing " << filename << "..." << endl;
+        vector<vector<int>> a = readInstance(filename, n, m);
+        return solveNative(filename, a, n, rho, time_limit, startFilename, threads);
+    }
+    cout << "Formulation: " << formulation;
+    if (formulation == "desagregee") cout << (lazyCuts ? " (cover cuts in user cut pool)" : " (cover cuts in model)");
+    cout << endl;
     
     int n, m;
     
@@ -81,67 +458,107 @@ int main(int argc, char** argv) {
     size_t lastSlash = baseName.find_last_of("/\\");
     if (lastSlash != string::npos) baseName = baseName.substr(lastSlash + 1);
     
-    string lpFilename = baseName + ".lp";
+    string lpFilename = tmpPath(baseName + ".lp");
     string scriptFilename = baseName + ".script";
     string logFilename = baseName + ".log";
+    string mstFilename = tmpPath(baseName + ".mst");
 
     // 1. Generate LP File
-    ofstream lpFile(lpFilename.c_str());
-    if (!lpFile.is_open()) {
-        cerr << "Error creating LP file: " << lpFilename << endl;
-        return 1;
-    }
+    bool withCovers = (formulation == "desagregee");
+    vector<CoverCut> separated;
+    int cutCount = 0;
+    // The LP relaxation ignores the "User Cuts" section: the cuts stay model rows until separation is done
+    bool lazyRows = lazyCuts && separationRounds == 0;
 
     cout << "Generating LP file: " << lpFilename << "..." << endl;
+    auto lpStart = high_resolution_clock::now();
+    if (!writeModel(lpFilename, a, n, rho, withCovers, lazyRows, maxCutsPerVertex, separated, cutCount)) {
+        cerr << "Error writing LP file: " << lpFilename << endl;
+        return 1;
+    }
+    cout << "LP emission time: "
+         << duration_cast<microseconds>(high_resolution_clock::now() - lpStart).count() / 1000.0
+         << " ms" << endl;
 
-    // LP Header
-    lpFile << "Minimize" << endl;
-    lpFile << " obj: ";
-    for (int i = 0; i < n; i++) {
-        lpFile << "x" << (i + 1);
-        if (i < n - 1) lpFile << " + ";
+    // 1a. Separation rounds: the most violated cover of each vertex at the LP optimum
+    for (int round = 1; round <= separationRounds; round++) {
+        vector<double> x;
+        double bound = 0.0;
+        if (!runLpRelaxation(lpFilename, baseName, n, x, bound)) {
+            cerr << "Separation: LP relaxation failed, see " << baseName << ".sep.log" << endl;
+            break;
+        }
+        int added = separateCovers(a, n, rho, x, separated);
+        cout << "Separation round " << round << ": LP bound " << bound << ", " << added
+             << " violated covers" << endl;
+        if (added == 0) break;
+        if (!writeModel(lpFilename, a, n, rho, withCovers, false, maxCutsPerVertex, separated, cutCount)) {
+            cerr << "Error writing LP file: " << lpFilename << endl;
+            return 1;
+        }
     }
-    lpFile << endl;
+    if (lazyCuts && !lazyRows &&
+        !writeModel(lpFilename, a, n, rho, withCovers, true, maxCutsPerVertex, separated, cutCount)) {
+        cerr << "Error writing LP file: " << lpFilename << endl;
+        return 1;
+    }
+    if (withCovers) cout << "Cover cuts: " << cutCount << " (" << separated.size() << " separated)" << endl;
+    cout << "LP file generated." << endl;
 
-    lpFile << "Subject To" << endl;
+    // 1b. MIP start from an initial solution (e.g. the lb_pids incumbent)
+    bool useStart = false;
+    double cutoff = -1.0;
+    if (!startFilename.empty()) {
+        vector<int> start = readStartSolution(startFilename, n);
+        vector<char> selected(n, 0);
+        for (size_t k = 0; k < start.size(); k++) selected[start[k]] = 1;
 
-    float rho = 0.5;
+        int card = 0;
+        for (int i = 0; i < n; i++) card += selected[i];
 
-    for (int i = 0; i < n; i++) {
-        int deg_i = 0;
-        vector<int> neighbors;
-        
-        for (int j = 0; j < n; j++) {
-            if (a[i][j] == 1) {
-                deg_i++;
-                neighbors.push_back(j);
+        // Check feasibility before trusting it as a cutoff
+        bool feasible = true;
+        for (int i = 0; i < n && feasible; i++) {
+            if (selected[i]) continue;
+            int deg_i = 0, covered = 0;
+            for (int j = 0; j < n; j++) {
+                if (a[i][j] == 1) {
+                    deg_i++;
+                    covered += selected[j];
+                }
             }
+            if (covered < threshold(rho, deg_i)) feasible = false;
         }
 
-        // Constraint: sum(x_j) + M*x_i >= ceil(0.5 * deg_i)
-        int rhs = (int)ceil(rho * deg_i);
-
-        lpFile << " c" << (i + 1) << ": ";
-        
-        for (size_t k = 0; k < neighbors.size(); k++) {
-            lpFile << "x" << (neighbors[k] + 1) << " + ";
+        BufferedWriter mstFile(1 << 16);
+        if (!mstFile.open(mstFilename)) {
+            cerr << "Error creating MST file: " << mstFilename << endl;
+            return 1;
+        }
+        mstFile.put("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                    "<CPLEXSolutions>\n"
+                    " <CPLEXSolution version=\"1.0\">\n"
+                    "  <header/>\n"
+                    "  <variables>\n");
+        for (int i = 0; i < n; i++) {
+            mstFile.put("   <variable name=\"").putVar(i).put("\" value=\"")
+                   .putInt(selected[i]).put("\"/>\n");
+        }
+        mstFile.put("  </variables>\n"
+                    " </CPLEXSolution>\n"
+                    "</CPLEXSolutions>\n");
+        if (!mstFile.close()) {
+            cerr << "Error writing MST file: " << mstFilename << endl;
+            return 1;
         }
-        
-        // Use rhs as the coefficient for x[i] (Big-M)
-        lpFile << rhs << " x" << (i + 1);
-        
-        lpFile << " >= " << rhs << endl; 
-    }
 
-    lpFile << "Binaries" << endl;
-    for (int i = 0; i < n; i++) {
-        lpFile << " x" << (i + 1) << endl;
+        useStart = true;
+        cout << "MIP start: " << startFilename << " (cardinality " << card
+             << (feasible ? ", feasible" : ", INFEASIBLE - no cutoff") << ")" << endl;
+        // The start itself has value card, so nodes above card can be pruned
+        if (feasible) cutoff = card;
     }
 
-    lpFile << "End" << endl;
-    lpFile.close();
-    cout << "LP file generated." << endl;
-
     // 2. Create Unique CPLEX Script
     ofstream scriptFile(scriptFilename.c_str());
     if (!scriptFile.is_open()) {
@@ -149,7 +566,9 @@ int main(int argc, char** argv) {
          return 1;
     }
     scriptFile << "read " << lpFilename << endl;
+    if (useStart) scriptFile << "read " << mstFilename << endl;
     scriptFile << "set timelimit " << time_limit << endl;
+    if (cutoff >= 0.0) scriptFile << "set mip tolerances uppercutoff " << cutoff << endl;
     scriptFile << "optimize" << endl;
     // scriptFile << "set mip display 2" << endl; // detailed log if needed
     scriptFile << "display solution variables -" << endl; // Display all non-zero variables
@@ -244,32 +663,8 @@ int main(int argc, char** argv) {
         cerr << "Could not open " << logFilename << " for parsing." << endl;
     }
 
-    // Output results
-    cout << "\n--- Final Results ---" << endl;
-    cout << "Objective: " << objective << endl;
-    cout << "Gap: " << gap << endl;
-    cout << "Cardinality: " << cardinality << endl;
-    cout << "Solution: " << endl;
-    for (size_t i = 0; i < solutionLines.size(); ++i) {
-        cout << solutionLines[i] << endl;
-    }
+    writeResults(filename, objective, gap, cardinality, solutionLines);
 
-    string outputFilename = filename + "OUTPUT";
-    ofstream outFile(outputFilename.c_str());
-    if (outFile.is_open()) {
-        outFile << "Objective: " << objective << endl;
-        outFile << "Gap: " << gap << endl;
-        outFile << "Cardinality: " << cardinality << endl;
-        outFile << "Solution: " << endl;
-        for (size_t i = 0; i < solutionLines.size(); ++i) {
-            outFile << solutionLines[i] << endl;
-        }
-        outFile.close();
-        cout << "Results saved to " << outputFilename << endl;
-    } else {
-        cerr << "Error saving results to " << outputFilename << endl;
-    }
-    
     // Cleanup temporary files
     // remove(lpFilename.c_str());
     // remove(scriptFilename.c_str());
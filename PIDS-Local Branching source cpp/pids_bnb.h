@@ -0,0 +1,587 @@
+/************************************************************
+     pids_bnb.h - Native branch-and-bound for PIDS models
+ ***********************************************************/
+
+#ifndef PIDS_BNB_H
+#define PIDS_BNB_H
+
+#include <climits>
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+ * The model that lb_pids writes as an LP file for CPLEX, given to the native solver
+ * in memory:
+ *   minimize sum x_v  s.t.  x_v = 1  or  sum_{u in N(v)} x_u >= h(v)   for every v
+ * with some variables fixed to 0 or 1 and optional Hamming distance constraints
+ * Delta(x, centre) <= radius (or >= radius once reversed) around 0/1 centres.
+ */
+struct PidsModel {
+    struct Distance {
+        std::vector<char> centre;   // 0/1 per vertex
+        int radius;
+        bool reversed;              // false: Delta <= radius, true: Delta >= radius
+    };
+
+    int n;
+    std::vector<uint64_t> start;    // CSR: the neighbours of v are targets[start[v] .. start[v+1])
+    std::vector<int> targets;
+    std::vector<int> threshold;     // h(v)
+    std::vector<signed char> fixed; // -1 free, 0 or 1; empty: all free
+    std::vector<Distance> distances;
+
+    PidsModel() : n(0), start(1, 0) {}
+};
+
+struct PidsBnbOptions {
+    double timeLimit;                      // seconds
+    int threads;
+    int upper;                             // only solutions of value <= upper are accepted
+    bool stopAtFirst;                      // stop at the first accepted solution
+    const std::vector<char>* start;        // 0/1 per vertex, used as incumbent if feasible and <= upper
+    const std::atomic<bool>* cancel;       // polled with the time limit
+
+    PidsBnbOptions()
+        : timeLimit(1e30), threads(1), upper(INT_MAX), stopAtFirst(false), start(NULL), cancel(NULL) {}
+};
+
+struct PidsBnbResult {
+    // FEASIBLE and NO_SOLUTION: stopped early (time limit, cancel or stopAtFirst)
+    enum Status { OPTIMAL, INFEASIBLE, FEASIBLE, NO_SOLUTION };
+
+    Status status;
+    std::vector<int> selected;   // Vertices at 1 when a solution was found
+    int value;                   // Its value, INT_MAX otherwise
+    int bound;                   // Proven lower bound on the value of any accepted solution
+    long long nodes;
+};
+
+/*
+ * Depth-first branch-and-bound specialised for PIDS.
+ *
+ * The constructor removes the fixed variables: each remaining constraint asks for
+ * need(c) more selected vertices among its free neighbours, unless its own free
+ * variable is set to 1. A search node keeps, per constraint, need(c) and the number
+ * of still undecided free neighbours, updated incrementally on each assignment and
+ * undone through a trail. The undecided and selected free variables are bitsets, and
+ * so is each constraint's neighbourhood: forced assignments are found word by word.
+ *
+ * Propagation (to a fixpoint, after every branching decision):
+ *  - c can no longer be covered by its neighbours: its own variable is forced to 1,
+ *    or the node is infeasible if that variable is 0;
+ *  - c's variable is 0 and exactly need(c) neighbours are left: they are forced to 1;
+ *  - the value reaches the incumbent bound: every undecided variable is forced to 0;
+ *  - a distance constraint is tight: every undecided variable is forced to (or away
+ *    from) its centre value.
+ * Lower bound: one more selected vertex u lowers the total remaining need by at most
+ * its number of open neighbour constraints, plus need(u) if its own constraint is
+ * open. Taking the largest such reductions first gives the fewest vertices that can
+ * still cover the total need (no LP). Branching picks the open constraint with the
+ * least slack and, in it, the candidate with the largest reduction; 1 is tried first.
+ *
+ * With several threads, the first levels of the tree are expanded into subtrees
+ * that the threads take from a shared counter. They share the incumbent bound.
+ */
+class PidsBranchAndBound {
+public:
+    explicit PidsBranchAndBound(const PidsModel& model)
+        : n_(model.n), k_(0), constOnes_(0), infeasible_(false) {
+        std::vector<int> localOf(n_, -1);
+        std::vector<signed char> fixed = model.fixed;
+        if (fixed.empty()) fixed.assign(n_, -1);
+        for (int v = 0; v < n_; ++v) {
+            if (fixed[v] == -1) {
+                localOf[v] = k_++;
+                globalOf_.push_back(v);
+            } else if (fixed[v] == 1) {
+                constOnes_++;
+                fixedOnes_.push_back(v);
+            }
+        }
+        words_ = (k_ + 63) / 64;
+
+        // Constraints left once the fixed variables are taken into account
+        consStart_.push_back(0);
+        for (int c = 0; c < n_; ++c) {
+            if (fixed[c] == 1) continue;
+            int have = 0, free = 0;
+            for (uint64_t e = model.start[c]; e < model.start[c + 1]; ++e) {
+                int u = model.targets[e];
+                if (fixed[u] == 1) have++;
+                else if (fixed[u] == -1) free++;
+            }
+            int need = model.threshold[c] - have;
+            if (need <= 0) continue;
+            if (localOf[c] < 0 && free < need) {
+                infeasible_ = true;
+                continue;
+            }
+            need0_.push_back(need);
+            own_.push_back(localOf[c]);
+            for (uint64_t e = model.start[c]; e < model.start[c + 1]; ++e) {
+                int u = model.targets[e];
+                if (fixed[u] == -1) members_.push_back(localOf[u]);
+            }
+            consStart_.push_back(members_.size());
+        }
+        int C = need0_.size();
+
+        ownCons_.assign(k_, -1);
+        varStart_.assign(k_ + 1, 0);
+        for (int c = 0; c < C; ++c) {
+            if (own_[c] >= 0) ownCons_[own_[c]] = c;
+            for (uint64_t e = consStart_[c]; e < consStart_[c + 1]; ++e) varStart_[members_[e] + 1]++;
+        }
+        for (int u = 0; u < k_; ++u) varStart_[u + 1] += varStart_[u];
+        varCons_.resize(varStart_[k_]);
+        std::vector<uint64_t> position(varStart_.begin(), varStart_.end() - 1);
+        for (int c = 0; c < C; ++c) {
+            for (uint64_t e = consStart_[c]; e < consStart_[c + 1]; ++e) varCons_[position[members_[e]]++] = c;
+        }
+
+        // Neighbourhood bitsets, unless they would take more than 64 MB
+        if ((uint64_t)C * words_ <= (8u << 20)) {
+            rows_.assign((size_t)C * words_, 0);
+            for (int c = 0; c < C; ++c) {
+                for (uint64_t e = consStart_[c]; e < consStart_[c + 1]; ++e) {
+                    rows_[(size_t)c * words_ + (members_[e] >> 6)] |= 1ULL << (members_[e] & 63);
+                }
+            }
+        }
+
+        for (size_t d = 0; d < model.distances.size(); ++d) {
+            const PidsModel::Distance& dist = model.distances[d];
+            radius_.push_back(dist.radius);
+            reversed_.push_back(dist.reversed);
+            int changes = 0;
+            centre_.resize(centre_.size() + words_, 0);
+            for (int v = 0; v < n_; ++v) {
+                if (fixed[v] == -1) {
+                    if (dist.centre[v]) centre_[d * words_ + (localOf[v] >> 6)] |= 1ULL << (localOf[v] & 63);
+                } else {
+                    changes += fixed[v] != dist.centre[v];
+                }
+            }
+            changes0_.push_back(changes);
+        }
+    }
+
+    int freeVariables() const { return k_; }
+    int constraints() const { return need0_.size(); }
+
+    PidsBnbResult solve(const PidsBnbOptions& options) {
+        options_ = options;
+        deadline_ = std::chrono::steady_clock::now() +
+                    std::chrono::microseconds((long long)(std::min(options.timeLimit, 1e9) * 1e6));
+        stop_ = false;
+        limit_ = options.upper;
+        bestValue_ = INT_MAX;
+        nodes_ = 0;
+
+        PidsBnbResult result;
+        result.nodes = 0;
+        result.bound = INT_MAX;
+        if (infeasible_) return finish(result, INT_MAX);
+
+        if (options.start) useStart(*options.start);
+
+        Worker root;
+        initialise(root);
+        bool ok = checkAll(root) && propagate(root, 0);
+        int rootBound = INT_MAX;
+        if (ok) {
+            int branch;
+            rootBound = constOnes_ + root.nOnes + lowerBound(root, branch);
+        }
+        if (!ok || rootBound > limit_) return finish(result, rootBound);
+
+        int threads = std::max(1, options.threads);
+        if (threads == 1) {
+            explore(root, -1, NULL);
+            nodes_ += root.nodes;
+        } else {
+            // First levels expanded into subtrees, then taken by the threads in order
+            int depth = 0;
+            while ((1 << depth) < 16 * threads && depth < 20) depth++;
+            std::vector<std::vector<int>> tasks;
+            explore(root, depth, &tasks);
+            nodes_ += root.nodes;
+
+            std::atomic<size_t> next(0);
+            std::vector<std::thread> pool;
+            for (int t = 0; t < threads; ++t) {
+                pool.push_back(std::thread([&, this]() {
+                    Worker w = root;
+                    w.nodes = 0;
+                    size_t mark = w.trail.size();
+                    for (size_t i = next++; i < tasks.size() && !stop_; i = next++) {
+                        bool feasible = true;
+                        for (size_t j = 0; j < tasks[i].size() && feasible; ++j) {
+                            // A better incumbent may have forced the variable since the split
+                            int u = tasks[i][j] >> 1, value = tasks[i][j] & 1;
+                            if (w.value[u] != -1) {
+                                feasible = w.value[u] == value;
+                                continue;
+                            }
+                            size_t from = w.trail.size();
+                            assign(w, u, value);
+                            feasible = propagate(w, from);
+                        }
+                        if (feasible) explore(w, -1, NULL);
+                        undo(w, mark);
+                    }
+                    nodes_ += w.nodes;
+                }));
+            }
+            for (size_t t = 0; t < pool.size(); ++t) pool[t].join();
+        }
+        return finish(result, rootBound);
+    }
+
+private:
+    struct Worker {
+        std::vector<signed char> value;   // -1 undecided, 0, 1 (free variables)
+        std::vector<uint64_t> undecided, ones;
+        std::vector<int> need, avail;     // Per constraint: missing and undecided neighbours
+        std::vector<int> changes;         // Per distance constraint
+        std::vector<int> trail;           // Assigned variables, in order
+        std::vector<int> reduction, candidates, path;
+        int nOnes, nUndecided;
+        long long nodes;
+    };
+
+    void initialise(Worker& w) const {
+        int C = need0_.size();
+        w.value.assign(k_, -1);
+        w.undecided.assign(words_, ~0ULL);
+        if (k_ % 64) w.undecided[words_ - 1] = (1ULL << (k_ % 64)) - 1;
+        w.ones.assign(words_, 0);
+        w.need = need0_;
+        w.avail.resize(C);
+        for (int c = 0; c < C; ++c) w.avail[c] = consStart_[c + 1] - consStart_[c];
+        w.changes = changes0_;
+        w.reduction.assign(k_, 0);
+        w.nOnes = 0;
+        w.nUndecided = k_;
+        w.nodes = 0;
+    }
+
+    bool centreBit(size_t d, int u) const { return (centre_[d * words_ + (u >> 6)] >> (u & 63)) & 1; }
+
+    void assign(Worker& w, int u, int value) const {
+        w.value[u] = value;
+        w.undecided[u >> 6] &= ~(1ULL << (u & 63));
+        w.nUndecided--;
+        if (value) {
+            w.ones[u >> 6] |= 1ULL << (u & 63);
+            w.nOnes++;
+        }
+        for (uint64_t e = varStart_[u]; e < varStart_[u + 1]; ++e) {
+            w.avail[varCons_[e]]--;
+            w.need[varCons_[e]] -= value;
+        }
+        for (size_t d = 0; d < radius_.size(); ++d) w.changes[d] += value != (int)centreBit(d, u);
+        w.trail.push_back(u);
+    }
+
+    void undo(Worker& w, size_t mark) const {
+        while (w.trail.size() > mark) {
+            int u = w.trail.back();
+            w.trail.pop_back();
+            int value = w.value[u];
+            w.value[u] = -1;
+            w.undecided[u >> 6] |= 1ULL << (u & 63);
+            w.nUndecided++;
+            if (value) {
+                w.ones[u >> 6] &= ~(1ULL << (u & 63));
+                w.nOnes--;
+            }
+            for (uint64_t e = varStart_[u]; e < varStart_[u + 1]; ++e) {
+                w.avail[varCons_[e]]++;
+                w.need[varCons_[e]] += value;
+            }
+            for (size_t d = 0; d < radius_.size(); ++d) w.changes[d] -= value != (int)centreBit(d, u);
+        }
+    }
+
+    bool open(const Worker& w, int c) const {
+        return w.need[c] > 0 && !(own_[c] >= 0 && w.value[own_[c]] == 1);
+    }
+
+    // Assigns every undecided variable of mask (word by word) to value, or value ^ its mask bit
+    template <class Mask>
+    void forceAll(Worker& w, Mask mask, int value) const {
+        for (int i = 0; i < words_; ++i) {
+            uint64_t word = w.undecided[i] & mask(i);
+            while (word) {
+                int u = i * 64 + __builtin_ctzll(word);
+                word &= word - 1;
+                assign(w, u, value);
+            }
+        }
+    }
+
+    bool checkConstraint(Worker& w, int c) const {
+        if (!open(w, c)) return true;
+        bool ownFree = own_[c] >= 0 && w.value[own_[c]] == -1;
+        if (w.avail[c] < w.need[c]) {
+            if (!ownFree) return false;
+            assign(w, own_[c], 1);
+        } else if (w.avail[c] == w.need[c] && !ownFree) {
+            if (!rows_.empty()) {
+                const uint64_t* row = &rows_[(size_t)c * words_];
+                forceAll(w, [row](int i) { return row[i]; }, 1);
+            } else {
+                for (uint64_t e = consStart_[c]; e < consStart_[c + 1]; ++e) {
+                    if (w.value[members_[e]] == -1) assign(w, members_[e], 1);
+                }
+            }
+        }
+        return true;
+    }
+
+    bool checkGlobal(Worker& w) const {
+        int total = constOnes_ + w.nOnes;
+        int limit = limit_.load(std::memory_order_relaxed);
+        if (total > limit) return false;
+        if (total == limit && w.nUndecided > 0) forceAll(w, [](int) { return ~0ULL; }, 0);
+
+        for (size_t d = 0; d < radius_.size(); ++d) {
+            const uint64_t* centre = &centre_[d * words_];
+            if (!reversed_[d]) {
+                if (w.changes[d] > radius_[d]) return false;
+                if (w.changes[d] == radius_[d] && w.nUndecided > 0) {
+                    forceAll(w, [centre](int i) { return centre[i]; }, 1);
+                    forceAll(w, [centre](int i) { return ~centre[i]; }, 0);
+                }
+            } else {
+                if (w.changes[d] + w.nUndecided < radius_[d]) return false;
+                if (w.changes[d] + w.nUndecided == radius_[d] && w.nUndecided > 0) {
+                    forceAll(w, [centre](int i) { return centre[i]; }, 0);
+                    forceAll(w, [centre](int i) { return ~centre[i]; }, 1);
+                }
+            }
+        }
+        return true;
+    }
+
+    bool checkAll(Worker& w) const {
+        for (int c = 0; c < (int)need0_.size(); ++c) {
+            if (!checkConstraint(w, c)) return false;
+        }
+        return checkGlobal(w);
+    }
+
+    // Processes the trail from position from until no rule applies
+    bool propagate(Worker& w, size_t from) const {
+        for (size_t q = from; q < w.trail.size(); ++q) {
+            int u = w.trail[q];
+            for (uint64_t e = varStart_[u]; e < varStart_[u + 1]; ++e) {
+                if (!checkConstraint(w, varCons_[e])) return false;
+            }
+            if (ownCons_[u] >= 0 && !checkConstraint(w, ownCons_[u])) return false;
+            if (!checkGlobal(w)) return false;
+        }
+        return true;
+    }
+
+    /*
+     * Fewest additional vertices that can cover the total need (INT_MAX / 2 if none),
+     * and the branching variable (-1 when every constraint is satisfied).
+     */
+    int lowerBound(Worker& w, int& branch) const {
+        long long total = 0;
+        int best = -1, bestSlack = INT_MAX;
+        w.candidates.clear();
+        for (int c = 0; c < (int)need0_.size(); ++c) {
+            if (!open(w, c)) continue;
+            total += w.need[c];
+            bool ownFree = own_[c] >= 0 && w.value[own_[c]] == -1;
+            for (uint64_t e = consStart_[c]; e < consStart_[c + 1]; ++e) {
+                int u = members_[e];
+                if (w.value[u] != -1) continue;
+                if (w.reduction[u]++ == 0) w.candidates.push_back(u);
+            }
+            if (ownFree) {
+                if (w.reduction[own_[c]] == 0) w.candidates.push_back(own_[c]);
+                w.reduction[own_[c]] += w.need[c];
+            }
+            int slack = w.avail[c] + ownFree - w.need[c];
+            if (slack < bestSlack || (slack == bestSlack && w.need[c] > w.need[best])) {
+                bestSlack = slack;
+                best = c;
+            }
+        }
+
+        branch = -1;
+        if (best >= 0) {
+            int bestReduction = -1;
+            if (own_[best] >= 0 && w.value[own_[best]] == -1) {
+                branch = own_[best];
+                bestReduction = w.reduction[branch];
+            }
+            for (uint64_t e = consStart_[best]; e < consStart_[best + 1]; ++e) {
+                int u = members_[e];
+                if (w.value[u] == -1 && w.reduction[u] > bestReduction) {
+                    bestReduction = w.reduction[u];
+                    branch = u;
+                }
+            }
+        }
+
+        std::vector<int>& r = w.candidates;  // Now the reductions, sorted below
+        for (size_t i = 0; i < r.size(); ++i) {
+            int u = r[i];
+            r[i] = w.reduction[u];
+            w.reduction[u] = 0;
+        }
+        if (total == 0) return 0;
+        std::sort(r.begin(), r.end(), std::greater<int>());
+        long long covered = 0;
+        for (size_t i = 0; i < r.size(); ++i) {
+            covered += r[i];
+            if (covered >= total) return i + 1;
+        }
+        return INT_MAX / 2;
+    }
+
+    bool timeUp(Worker& w) {
+        if ((++w.nodes & 255) == 0) {
+            if (std::chrono::steady_clock::now() >= deadline_ || (options_.cancel && options_.cancel->load())) {
+                stop_ = true;
+            }
+        }
+        return stop_;
+    }
+
+    void record(const Worker& w) {
+        int value = constOnes_ + w.nOnes;
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (value >= bestValue_ || value > limit_) return;
+        bestValue_ = value;
+        best_.clear();
+        best_.insert(best_.end(), fixedOnes_.begin(), fixedOnes_.end());
+        for (int u = 0; u < k_; ++u) {
+            if (w.value[u] == 1) best_.push_back(globalOf_[u]);
+        }
+        std::sort(best_.begin(), best_.end());
+        limit_ = value - 1;
+        if (options_.stopAtFirst) stop_ = true;
+    }
+
+    /*
+     * Every constraint is satisfied: the undecided variables go to 0, unless a distance
+     * constraint then fails. Returns the variable to branch on in that case, -2 if the
+     * node is a solution or cannot be completed.
+     */
+    int complete(Worker& w) {
+        for (size_t d = 0; d < radius_.size(); ++d) {
+            const uint64_t* centre = &centre_[d * words_];
+            int changes = w.changes[d];
+            for (int i = 0; i < words_; ++i) changes += __builtin_popcountll(w.undecided[i] & centre[i]);
+            bool fails = reversed_[d] ? changes < radius_[d] : changes > radius_[d];
+            if (!fails) continue;
+            // <=: select a centre vertex instead; >=: select a vertex outside the centre
+            for (int i = 0; i < words_; ++i) {
+                uint64_t word = w.undecided[i] & (reversed_[d] ? ~centre[i] : centre[i]);
+                if (word) return i * 64 + __builtin_ctzll(word);
+            }
+            return -2;
+        }
+        record(w);
+        return -2;
+    }
+
+    /*
+     * Depth-first search below the current node. With tasks, stops depth levels
+     * further down and stores the decisions leading to each open node instead.
+     */
+    void explore(Worker& w, int depth, std::vector<std::vector<int>>* tasks) {
+        if (timeUp(w)) return;
+        int branch;
+        int bound = constOnes_ + w.nOnes + lowerBound(w, branch);
+        if (bound > limit_.load(std::memory_order_relaxed)) return;
+        if (branch < 0) {
+            branch = complete(w);
+            if (branch < 0) return;
+        }
+        if (tasks && depth == 0) {
+            tasks->push_back(w.path);
+            return;
+        }
+        for (int value = 1; value >= 0; --value) {
+            size_t mark = w.trail.size();
+            assign(w, branch, value);
+            if (tasks) w.path.push_back(branch * 2 + value);
+            if (propagate(w, mark)) explore(w, depth - 1, tasks);
+            if (tasks) w.path.pop_back();
+            undo(w, mark);
+            if (stop_) return;
+        }
+    }
+
+    void useStart(const std::vector<char>& start) {
+        Worker w;
+        initialise(w);
+        for (int u = 0; u < k_; ++u) assign(w, u, start[globalOf_[u]] ? 1 : 0);  // Fixed variables keep their value
+        for (int c = 0; c < (int)need0_.size(); ++c) {
+            if (open(w, c)) return;
+        }
+        for (size_t d = 0; d < radius_.size(); ++d) {
+            if (reversed_[d] ? w.changes[d] < radius_[d] : w.changes[d] > radius_[d]) return;
+        }
+        bool stopAtFirst = options_.stopAtFirst;
+        options_.stopAtFirst = false;  // The start is not a new solution
+        record(w);
+        options_.stopAtFirst = stopAtFirst;
+    }
+
+    PidsBnbResult& finish(PidsBnbResult& result, int rootBound) {
+        bool found = bestValue_ != INT_MAX;
+        result.nodes = nodes_;
+        result.value = bestValue_;
+        result.selected = best_;
+        if (!stop_) {
+            result.status = found ? PidsBnbResult::OPTIMAL : PidsBnbResult::INFEASIBLE;
+            result.bound = found ? bestValue_ : options_.upper == INT_MAX ? INT_MAX : options_.upper + 1;
+        } else {
+            result.status = found ? PidsBnbResult::FEASIBLE : PidsBnbResult::NO_SOLUTION;
+            result.bound = found ? std::min(rootBound, bestValue_) : rootBound;
+        }
+        return result;
+    }
+
+    int n_, k_, words_;
+    int constOnes_;
+    bool infeasible_;                    // A constraint cannot be met whatever the free variables
+    std::vector<int> globalOf_;          // Free variable -> vertex
+    std::vector<int> fixedOnes_;         // Vertices fixed to 1
+
+    std::vector<int> need0_, own_;       // Per constraint: initial need, own free variable (-1: fixed to 0)
+    std::vector<uint64_t> consStart_;    // CSR of the free neighbours of each constraint
+    std::vector<int> members_;
+    std::vector<uint64_t> rows_;         // Same, as bitsets of words_ words (empty if too large)
+    std::vector<uint64_t> varStart_;     // CSR of the constraints that have u as a neighbour
+    std::vector<int> varCons_;
+    std::vector<int> ownCons_;           // Constraint of the variable's own vertex, -1 if none
+
+    std::vector<int> radius_, changes0_;
+    std::vector<char> reversed_;
+    std::vector<uint64_t> centre_;       // Centre bitsets over the free variables
+
+    PidsBnbOptions options_;
+    std::chrono::steady_clock::time_point deadline_;
+    std::atomic<bool> stop_;
+    std::atomic<int> limit_;             // Largest value still worth finding
+    std::atomic<long long> nodes_;
+    std::mutex mutex_;
+    int bestValue_;
+    std::vector<int> best_;
+};
+
+#endif
@@ -0,0 +1,71 @@
+#!/bin/bash
+# Three lb_pids processes cooperating on one instance (-coop), in both modes.
+#
+#   ./test_coop.sh <instance> [seconds]
+#
+# Shared memory: three processes, one of them with -ordre rcm; the segment must be
+# gone once the last one has exited.
+# Socket: same three processes; the one holding the slot is killed (SIGKILL) halfway.
+# Another process must take the slot over with the best solution published so far,
+# and the socket files must be gone at the end.
+#
+# LB (default ./lb_pids) and OPTIONS (default: native solver, short phases) can be
+# overridden, e.g. OPTIONS="-ti 5 -td 5" to use CPLEX.
+
+instance=$1
+duree=${2:-20}
+LB=${LB:-./lb_pids}
+OPTIONS=${OPTIONS:--solveur natif -ti 1 -td 1}
+nom=test_coop_$$
+repertoire=$(mktemp -d)
+export PIDS_TMPDIR=$repertoire
+echecs=0
+
+if [ -z "$instance" ] || [ ! -f "$instance" ]; then
+    echo "usage: $0 <instance> [seconds]"
+    exit 2
+fi
+
+verifier() {
+    if eval "$2"; then echo "  ok    $1"; else echo "  ECHEC $1"; echecs=$((echecs + 1)); fi
+}
+
+score() { grep -a "^Score optimal:" "$1" | awk '{ print $3 }'; }
+
+lancer() {
+    # $1: cooperation name, $2: prefix of the output files
+    $LB -i "$instance" -t "$duree" -seed 1 -coop "$1" $OPTIONS > "$2.1" 2>&1 &
+    pid1=$!
+    sleep 1  # The first process holds the slot in socket mode
+    $LB -i "$instance" -t "$duree" -seed 2 -coop "$1" -ordre rcm $OPTIONS > "$2.2" 2>&1 &
+    pid2=$!
+    $LB -i "$instance" -t "$duree" -seed 3 -coop "$1" $OPTIONS > "$2.3" 2>&1 &
+    pid3=$!
+}
+
+echo "Memoire partagee (/$nom)"
+lancer "$nom" "$repertoire/memoire"
+wait $pid1 $pid2 $pid3
+for i in 1 2 3; do echo "  processus $i: score $(score $repertoire/memoire.$i)"; done
+verifier "trois resultats" '[ $(cat $repertoire/memoire.? | grep -a -c "^Score optimal:") -eq 3 ]'
+verifier "solutions echangees" 'grep -a -q "solution adoptee" $repertoire/memoire.?'
+verifier "segment retire" '[ ! -e /dev/shm/$nom ]'
+
+echo "Socket ($repertoire/lb_pids_$nom.sock)"
+lancer "socket:$nom" "$repertoire/socket"
+sleep $((duree / 2))
+# Score of the slot (copied to <socket>.solution by its holder) just before the kill
+meilleur=$(awk '{ print $2 }' "$repertoire/lb_pids_$nom.sock.solution" 2>/dev/null)
+kill -9 $pid1
+echo "  processus 1 arrete (case: ${meilleur:-vide})"
+wait $pid2 $pid3
+for i in 2 3; do echo "  processus $i: score $(score $repertoire/socket.$i)"; done
+verifier "case reprise" 'grep -a -q "case reprise" $repertoire/socket.2 $repertoire/socket.3'
+if [ -n "$meilleur" ]; then
+    verifier "meilleure solution conservee" \
+        '[ $(score $repertoire/socket.2) -le $meilleur ] && [ $(score $repertoire/socket.3) -le $meilleur ]'
+fi
+verifier "fichiers retires" '[ -z "$(ls $repertoire | grep lb_pids_)" ]'
+
+rm -rf "$repertoire"
+[ $echecs -eq 0 ]